@@ -84,6 +84,7 @@ CPU::CPU()
     has_popcnt_(false),
     has_avx_(false),
     has_avx2_(false),
+    has_fma3_(false),
     has_aesni_(false),
     has_non_stop_time_stamp_counter_(false),
     is_running_in_vm_(false),
@@ -241,6 +242,7 @@ void CPU::Initialize() {
         (xgetbv(0) & 6) == 6 /* XSAVE enabled by kernel */;
     has_aesni_ = (cpu_info[2] & 0x02000000) != 0;
     has_avx2_ = has_avx_ && (cpu_info7[1] & 0x00000020) != 0;
+    has_fma3_ = has_avx_ && (cpu_info[2] & 0x00001000) != 0;
   }
 
   // Get the brand string of the cpu.
@@ -62,6 +62,7 @@ class BASE_EXPORT CPU final {
   bool has_popcnt() const { return has_popcnt_; }
   bool has_avx() const { return has_avx_; }
   bool has_avx2() const { return has_avx2_; }
+  bool has_fma3() const { return has_fma3_; }
   bool has_aesni() const { return has_aesni_; }
   bool has_non_stop_time_stamp_counter() const {
     return has_non_stop_time_stamp_counter_;
@@ -92,6 +93,7 @@ class BASE_EXPORT CPU final {
   bool has_popcnt_;
   bool has_avx_;
   bool has_avx2_;
+  bool has_fma3_;
   bool has_aesni_;
   bool has_non_stop_time_stamp_counter_;
   bool is_running_in_vm_;
@@ -6,6 +6,13 @@
 
 namespace gpu {
 
+void SharedImageInterface::DestroySharedImages(
+    const SyncToken& sync_token,
+    const std::vector<Mailbox>& mailboxes) {
+  for (const auto& mailbox : mailboxes)
+    DestroySharedImage(sync_token, mailbox);
+}
+
 uint32_t SharedImageInterface::UsageForMailbox(const Mailbox& mailbox) {
   return 0u;
 }
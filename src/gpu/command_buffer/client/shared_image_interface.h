@@ -5,6 +5,8 @@
 #ifndef GPU_COMMAND_BUFFER_CLIENT_SHARED_IMAGE_INTERFACE_H_
 #define GPU_COMMAND_BUFFER_CLIENT_SHARED_IMAGE_INTERFACE_H_
 
+#include <vector>
+
 #include "base/compiler_specific.h"
 #include "base/containers/span.h"
 #include "base/memory/scoped_refptr.h"
@@ -116,6 +118,12 @@ class GPU_EXPORT SharedImageInterface {
   virtual void DestroySharedImage(const SyncToken& sync_token,
                                   const Mailbox& mailbox) = 0;
 
+  // Destroys all of |mailboxes| after |sync_token| has been released, as if
+  // DestroySharedImage() was called for each. Implementations that talk to
+  // the GPU process over IPC send a single message for the whole batch.
+  virtual void DestroySharedImages(const SyncToken& sync_token,
+                                   const std::vector<Mailbox>& mailboxes);
+
   struct SwapChainMailboxes {
     Mailbox front_buffer;
     Mailbox back_buffer;
@@ -126,6 +126,7 @@ void TransferBuffer::AllocateRingBuffer(unsigned int size) {
       result_buffer_ = buffer_->memory();
       result_shm_offset_ = 0;
       bytes_since_last_shrink_ = 0;
+      waited_since_last_resize_ = false;
       return;
     }
     // we failed so don't try larger than this.
@@ -201,6 +202,14 @@ void TransferBuffer::ShrinkOrExpandRingBufferIfNecessary(
   if (size_to_allocate > available_size) {
     // Try to expand the ring buffer.
     ReallocateRingBuffer(high_water_mark_);
+  } else if (waited_since_last_resize_) {
+    // Earlier allocations had to wait for the service. Double the ring buffer
+    // now that no blocks are in use, so that the next burst of uploads has
+    // more room in flight.
+    waited_since_last_resize_ = false;
+    high_water_mark_ =
+        std::max(high_water_mark_, last_allocated_size_ * 2 - result_size_);
+    ReallocateRingBuffer(high_water_mark_);
   } else if (bytes_since_last_shrink_ > high_water_mark_ * kShrinkThreshold) {
     // The intent of the above check is to limit the frequency of buffer shrink
     // attempts. Unfortunately if an application uploads a large amount of data
@@ -230,7 +239,7 @@ void* TransferBuffer::AllocUpTo(
   unsigned int max_size = ring_buffer_->GetLargestFreeOrPendingSize();
   *size_allocated = std::min(max_size, size);
   bytes_since_last_shrink_ += *size_allocated;
-  return ring_buffer_->Alloc(*size_allocated);
+  return AllocFromRingBuffer(*size_allocated);
 }
 
 void* TransferBuffer::Alloc(unsigned int size) {
@@ -245,7 +254,21 @@ void* TransferBuffer::Alloc(unsigned int size) {
     return nullptr;
   }
   bytes_since_last_shrink_ += size;
-  return ring_buffer_->Alloc(size);
+  return AllocFromRingBuffer(size);
+}
+
+void* TransferBuffer::AllocFromRingBuffer(unsigned int size) {
+  // The ring buffer allocates at least 1 byte.
+  if (std::max(size, 1u) <= ring_buffer_->GetLargestFreeSizeNoWaiting())
+    return ring_buffer_->Alloc(size);
+
+  TRACE_EVENT1("gpu", "TransferBuffer::WaitForSpace", "size", size);
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  void* pointer = ring_buffer_->Alloc(size);
+  total_wait_time_ += base::TimeTicks::Now() - start_time;
+  num_waits_++;
+  waited_since_last_resize_ = true;
+  return pointer;
 }
 
 void* TransferBuffer::AcquireResultBuffer() {
@@ -13,6 +13,7 @@
 #include "base/compiler_specific.h"
 #include "base/containers/circular_deque.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "base/unguessable_token.h"
 #include "gpu/command_buffer/client/ring_buffer.h"
 #include "gpu/command_buffer/common/buffer.h"
@@ -114,6 +115,11 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   // These are for testing.
   unsigned int GetCurrentMaxAllocationWithoutRealloc() const;
 
+  // Number of allocations that had to wait for the service to consume earlier
+  // allocations, and the total time spent waiting.
+  unsigned int num_waits() const { return num_waits_; }
+  base::TimeDelta total_wait_time() const { return total_wait_time_; }
+
   // We will attempt to shrink the ring buffer once the number of bytes
   // allocated reaches this threshold times the high water mark.
   static const int kShrinkThreshold = 120;
@@ -126,6 +132,10 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
 
   void ShrinkOrExpandRingBufferIfNecessary(unsigned int size);
 
+  // Allocates |size| bytes from the ring buffer, recording the time spent if
+  // the allocation has to wait for a token.
+  void* AllocFromRingBuffer(unsigned int size);
+
   // Returns the number of bytes that are still in use in ring buffers that we
   // previously freed.
   unsigned int GetPreviousRingBufferUsedBytes();
@@ -158,6 +168,14 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   // Number of bytes since we last attempted to shrink the ring buffer.
   unsigned int bytes_since_last_shrink_ = 0;
 
+  // True if an allocation waited for a token since the ring buffer was last
+  // resized. The buffer is then too small for the rate at which the service
+  // consumes uploads, so it is grown the next time it is idle.
+  bool waited_since_last_resize_ = false;
+
+  unsigned int num_waits_ = 0;
+  base::TimeDelta total_wait_time_;
+
   // the current buffer.
   scoped_refptr<gpu::Buffer> buffer_;
 
@@ -426,6 +426,52 @@ TEST_F(TransferBufferExpandContractTest, NoExpandWithInUseAllocation) {
             transfer_buffer_->GetCurrentMaxAllocationWithoutRealloc());
 }
 
+// Verify that the ring buffer grows once idle after an allocation had to wait.
+TEST_F(TransferBufferExpandContractTest, ExpandAfterWait) {
+  EXPECT_CALL(*command_buffer(), Flush(_)).Times(1).RetiresOnSaturation();
+
+  int32_t token = helper_->InsertToken();
+  EXPECT_FALSE(helper_->HasTokenPassed(token));
+
+  // Fill the free space in two blocks and keep the second one in use.
+  uint32_t block_size_1 = transfer_buffer_->GetFreeSize() / 2;
+  uint32_t block_size_2 = transfer_buffer_->GetFreeSize() - block_size_1;
+  uint32_t size_allocated = 0;
+  void* block1 = transfer_buffer_->AllocUpTo(block_size_1, &size_allocated);
+  void* block2 = transfer_buffer_->AllocUpTo(block_size_2, &size_allocated);
+  transfer_buffer_->FreePendingToken(block1, token);
+  EXPECT_EQ(0u, transfer_buffer_->num_waits());
+
+  // This allocation can't expand the buffer and has to wait for |token|.
+  void* block3 = transfer_buffer_->AllocUpTo(1, &size_allocated);
+  ASSERT_TRUE(block3 != nullptr);
+  EXPECT_EQ(1u, transfer_buffer_->num_waits());
+  EXPECT_GE(transfer_buffer_->total_wait_time(), base::TimeDelta());
+  transfer_buffer_->FreePendingToken(block3, token);
+  transfer_buffer_->FreePendingToken(block2, token);
+
+  // The next allocation, with no blocks in use, doubles the buffer even
+  // though it fits.
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(kStartTransferBufferSize * 2, _))
+      .WillOnce(
+          Invoke(command_buffer(),
+                 &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+  void* ptr = transfer_buffer_->AllocUpTo(1, &size_allocated);
+  ASSERT_TRUE(ptr != nullptr);
+  transfer_buffer_->FreePendingToken(ptr, token);
+  EXPECT_EQ(kStartTransferBufferSize * 2 - kStartingOffset,
+            transfer_buffer_->GetCurrentMaxAllocationWithoutRealloc());
+  EXPECT_EQ(1u, transfer_buffer_->num_waits());
+}
+
 TEST_F(TransferBufferExpandContractTest, ExpandWithLargeAllocations) {
   int32_t token = helper_->InsertToken();
   EXPECT_FALSE(helper_->HasTokenPassed(token));
@@ -82,17 +82,18 @@ void GrShaderCache::PopulateCache(const std::string& key,
   if (data.length() > cache_size_limit_)
     return;
 
-  EnforceLimits(data.size());
-
   // If we already have this in the cache, skia may have populated it before it
   // was loaded off the disk cache. Its better to keep the latest version
-  // generated version than overwriting it here.
+  // generated version than overwriting it here. This is checked before making
+  // room, so that a duplicate does not evict other entries.
   std::string decoded_key;
   base::Base64Decode(key, &decoded_key);
   CacheKey cache_key(MakeData(decoded_key));
-  if (store_.Get(cache_key) != store_.end())
+  if (store_.Peek(cache_key) != store_.end())
     return;
 
+  EnforceLimits(data.size());
+
   CacheData cache_data(MakeData(data));
   auto it = AddToCache(cache_key, std::move(cache_data));
 
@@ -462,9 +462,25 @@ void MemoryProgramCache::SaveLinkedProgram(
 
 void MemoryProgramCache::LoadProgram(const std::string& key,
                                      const std::string& program) {
+  // The disk cache may hand out a program that was already loaded, e.g. for
+  // another client, or saved since. Keep the cached one; replacing it would
+  // cost a parse, and evicting the old value would clear the link status that
+  // the new value just recorded.
+  std::string decoded_key;
+  if (base::Base64Decode(key, &decoded_key) &&
+      decoded_key.size() == kHashLength &&
+      store_.Peek(decoded_key) != store_.end()) {
+    return;
+  }
+
   std::unique_ptr<GpuProgramProto> proto(
       GpuProgramProto::default_instance().New());
   if (proto->ParseFromString(program)) {
+    if (proto->program().length() > max_size_bytes() ||
+        store_.Peek(proto->sha()) != store_.end()) {
+      return;
+    }
+
     AttributeMap vertex_attribs;
     UniformMap vertex_uniforms;
     VaryingMap vertex_varyings;
@@ -522,6 +538,10 @@ void MemoryProgramCache::LoadProgram(const std::string& key,
     std::vector<uint8_t> binary(proto->program().length());
     memcpy(binary.data(), proto->program().c_str(), proto->program().length());
 
+    // Make room the same way SaveLinkedProgram() does, evicting the least
+    // recently used programs.
+    Trim(max_size_bytes() - binary.size());
+
     store_.Put(
         proto->sha(),
         new ProgramCacheValue(
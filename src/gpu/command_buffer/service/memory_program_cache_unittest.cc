@@ -260,6 +260,87 @@ TEST_F(MemoryProgramCacheTest, LoadProgram) {
                 GL_NONE));
 }
 
+TEST_F(MemoryProgramCacheTest, LoadProgramTwice) {
+  const GLenum kFormat = 1;
+  const int kProgramId = 10;
+  const int kBinaryLength = 20;
+  char test_binary[kBinaryLength];
+  for (int i = 0; i < kBinaryLength; ++i) {
+    test_binary[i] = i;
+  }
+  ProgramBinaryEmulator emulator(kBinaryLength, kFormat, test_binary);
+
+  SetExpectationsForSaveLinkedProgram(kProgramId, &emulator);
+  cache_->SaveLinkedProgram(kProgramId, vertex_shader_, fragment_shader_,
+                            nullptr, varyings_, GL_NONE, this);
+  cache_->Clear();
+
+  // The disk cache may provide the same program more than once, e.g. for
+  // several clients. The program must stay cached.
+  std::string blank;
+  cache_->LoadProgram(blank, shader_cache_shader());
+  cache_->LoadProgram(blank, shader_cache_shader());
+  EXPECT_EQ(ProgramCache::LINK_SUCCEEDED,
+            cache_->GetLinkedProgramStatus(
+                vertex_shader_->last_compiled_signature(),
+                fragment_shader_->last_compiled_signature(), nullptr, varyings_,
+                GL_NONE));
+  EXPECT_TRUE(cache_->HasSuccessfullyCompiledShader(
+      vertex_shader_->last_compiled_signature()));
+  EXPECT_TRUE(cache_->HasSuccessfullyCompiledShader(
+      fragment_shader_->last_compiled_signature()));
+}
+
+TEST_F(MemoryProgramCacheTest, LoadProgramEviction) {
+  const GLenum kFormat = 1;
+  const int kProgramId = 10;
+  const int kBinaryLength = 20;
+  char test_binary[kBinaryLength];
+  for (int i = 0; i < kBinaryLength; ++i) {
+    test_binary[i] = i;
+  }
+  ProgramBinaryEmulator emulator1(kBinaryLength, kFormat, test_binary);
+
+  SetExpectationsForSaveLinkedProgram(kProgramId, &emulator1);
+  cache_->SaveLinkedProgram(kProgramId, vertex_shader_, fragment_shader_,
+                            nullptr, varyings_, GL_NONE, this);
+  const std::string first_program = shader_cache_shader();
+  const std::string first_sig = fragment_shader_->last_compiled_signature();
+
+  const int kEvictingProgramId = 11;
+  const GLuint kEvictingBinaryLength = kCacheSizeBytes - kBinaryLength + 1;
+  fragment_shader_->set_source("al sdfkjdk");
+  TestHelper::SetShaderStates(gl_.get(), fragment_shader_, true);
+  std::unique_ptr<char[]> big_test_binary(new char[kEvictingBinaryLength]);
+  for (size_t i = 0; i < kEvictingBinaryLength; ++i) {
+    big_test_binary[i] = i % 250;
+  }
+  ProgramBinaryEmulator emulator2(kEvictingBinaryLength, kFormat,
+                                  big_test_binary.get());
+
+  SetExpectationsForSaveLinkedProgram(kEvictingProgramId, &emulator2);
+  cache_->SaveLinkedProgram(kEvictingProgramId, vertex_shader_,
+                            fragment_shader_, nullptr, varyings_, GL_NONE,
+                            this);
+  const std::string evicting_program = shader_cache_shader();
+  cache_->Clear();
+
+  // Loading both programs from the disk cache must not exceed the cache size.
+  std::string blank;
+  cache_->LoadProgram(blank, first_program);
+  cache_->LoadProgram(blank, evicting_program);
+  EXPECT_EQ(ProgramCache::LINK_SUCCEEDED,
+            cache_->GetLinkedProgramStatus(
+                vertex_shader_->last_compiled_signature(),
+                fragment_shader_->last_compiled_signature(), nullptr, varyings_,
+                GL_NONE));
+  EXPECT_EQ(
+      ProgramCache::LINK_UNKNOWN,
+      cache_->GetLinkedProgramStatus(vertex_shader_->last_compiled_signature(),
+                                     first_sig, nullptr, varyings_, GL_NONE));
+  EXPECT_FALSE(cache_->HasSuccessfullyCompiledShader(first_sig));
+}
+
 TEST_F(MemoryProgramCacheTest, CacheLoadMatchesSave) {
   const GLenum kFormat = 1;
   const int kProgramId = 10;
@@ -701,5 +782,44 @@ TEST_F(MemoryProgramCacheTest, MemoryProgramCacheTrim) {
                                      first_sig, nullptr, varyings_, GL_NONE));
 }
 
+TEST_F(MemoryProgramCacheTest, EvictionKeepsSharedShaders) {
+  // Insert two 20 byte programs sharing the vertex shader.
+  const GLenum kFormat = 1;
+  const int kProgramId = 10;
+  const int kBinaryLength = 20;
+  char test_binary[kBinaryLength];
+  for (int i = 0; i < kBinaryLength; ++i) {
+    test_binary[i] = i;
+  }
+  ProgramBinaryEmulator emulator1(kBinaryLength, kFormat, test_binary);
+
+  SetExpectationsForSaveLinkedProgram(kProgramId, &emulator1);
+  cache_->SaveLinkedProgram(kProgramId, vertex_shader_, fragment_shader_,
+                            nullptr, varyings_, GL_NONE, this);
+  const std::string first_sig = fragment_shader_->last_compiled_signature();
+
+  const int kSecondProgramId = 11;
+  fragment_shader_->set_source("al sdfkjdk");
+  TestHelper::SetShaderStates(gl_.get(), fragment_shader_, true);
+  ProgramBinaryEmulator emulator2(kBinaryLength, kFormat, test_binary);
+
+  SetExpectationsForSaveLinkedProgram(kSecondProgramId, &emulator2);
+  cache_->SaveLinkedProgram(kSecondProgramId, vertex_shader_, fragment_shader_,
+                            nullptr, varyings_, GL_NONE, this);
+
+  // Evicting the first program keeps the vertex shader, which the second
+  // program still uses.
+  cache_->Trim(20);
+  EXPECT_FALSE(cache_->HasSuccessfullyCompiledShader(first_sig));
+  EXPECT_TRUE(cache_->HasSuccessfullyCompiledShader(
+      vertex_shader_->last_compiled_signature()));
+  EXPECT_TRUE(cache_->HasSuccessfullyCompiledShader(
+      fragment_shader_->last_compiled_signature()));
+
+  cache_->Trim(0);
+  EXPECT_FALSE(cache_->HasSuccessfullyCompiledShader(
+      vertex_shader_->last_compiled_signature()));
+}
+
 }  // namespace gles2
 }  // namespace gpu
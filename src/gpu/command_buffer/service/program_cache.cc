@@ -107,7 +107,7 @@ void ProgramCache::LinkedProgramCacheSuccess(const std::string& program_hash) {
 }
 
 void ProgramCache::CompiledShaderCacheSuccess(const std::string& shader_hash) {
-  compiled_shaders_.insert(shader_hash);
+  ++compiled_shaders_[shader_hash];
 }
 
 void ProgramCache::ComputeShaderHash(
@@ -121,8 +121,14 @@ void ProgramCache::Evict(const std::string& program_hash,
                          const std::string& shader_0_hash,
                          const std::string& shader_1_hash) {
   link_status_.erase(program_hash);
-  compiled_shaders_.erase(shader_0_hash);
-  compiled_shaders_.erase(shader_1_hash);
+  ReleaseCompiledShader(shader_0_hash);
+  ReleaseCompiledShader(shader_1_hash);
+}
+
+void ProgramCache::ReleaseCompiledShader(const std::string& shader_hash) {
+  auto found = compiled_shaders_.find(shader_hash);
+  if (found != compiled_shaders_.end() && --found->second == 0)
+    compiled_shaders_.erase(found);
 }
 
 namespace {
@@ -10,7 +10,6 @@
 #include <map>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 
 #include "base/hash/sha1.h"
 #include "base/macros.h"
@@ -144,15 +143,22 @@ class GPU_GLES2_EXPORT ProgramCache {
 
  private:
   typedef std::unordered_map<std::string, LinkedProgramStatus> LinkStatusMap;
-  typedef std::unordered_set<std::string> CachedCompiledShaderSet;
+  // Maps the hash of a compiled shader to the number of cached programs
+  // using it.
+  typedef std::unordered_map<std::string, int> CachedCompiledShaderMap;
+
+  // Drops one use of |shader_hash| by a cached program.
+  void ReleaseCompiledShader(const std::string& shader_hash);
 
   // called to clear the backend cache
   virtual void ClearBackend() = 0;
 
   const size_t max_size_bytes_;
   LinkStatusMap link_status_;
-  // only cache the hash of successfully compiled shaders
-  CachedCompiledShaderSet compiled_shaders_;
+  // only cache the hash of successfully compiled shaders. A shader stays here
+  // as long as any cached program uses it, so that evicting one program does
+  // not force compiling shaders it shares with programs still in the cache.
+  CachedCompiledShaderMap compiled_shaders_;
 
   DISALLOW_COPY_AND_ASSIGN(ProgramCache);
 };
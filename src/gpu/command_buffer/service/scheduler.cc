@@ -65,12 +65,15 @@ Scheduler::Sequence::WaitFence& Scheduler::Sequence::WaitFence::operator=(
 Scheduler::Sequence::Sequence(Scheduler* scheduler,
                               SequenceId sequence_id,
                               SchedulingPriority priority,
-                              scoped_refptr<SyncPointOrderData> order_data)
+                              scoped_refptr<SyncPointOrderData> order_data,
+                              scoped_refptr<base::SingleThreadTaskRunner>
+                                  task_runner)
     : scheduler_(scheduler),
       sequence_id_(sequence_id),
       default_priority_(priority),
       current_priority_(priority),
-      order_data_(std::move(order_data)) {}
+      order_data_(std::move(order_data)),
+      task_runner_(std::move(task_runner)) {}
 
 Scheduler::Sequence::~Sequence() {
   for (auto& kv : wait_fences_) {
@@ -294,16 +297,58 @@ void Scheduler::Sequence::RemoveClientWait(CommandBufferId command_buffer_id) {
   UpdateSchedulingPriority();
 }
 
+Scheduler::ForeignThreadHandle::ForeignThreadHandle(Scheduler* scheduler)
+    : no_running_callbacks_(&lock_), scheduler_(scheduler) {}
+
+Scheduler::ForeignThreadHandle::~ForeignThreadHandle() = default;
+
+void Scheduler::ForeignThreadHandle::RunIfAlive(
+    base::OnceCallback<void(Scheduler*)> callback) {
+  Scheduler* scheduler;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (!scheduler_)
+      return;
+    scheduler = scheduler_;
+    ++running_callbacks_;
+  }
+  // |lock_| isn't held while |callback| runs, as it may run tasks which post
+  // more of these.
+  std::move(callback).Run(scheduler);
+  base::AutoLock auto_lock(lock_);
+  if (--running_callbacks_ == 0)
+    no_running_callbacks_.Broadcast();
+}
+
+void Scheduler::ForeignThreadHandle::Invalidate() {
+  base::AutoLock auto_lock(lock_);
+  scheduler_ = nullptr;
+  while (running_callbacks_ > 0)
+    no_running_callbacks_.Wait();
+}
+
+Scheduler::PerThreadState::PerThreadState(
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner)
+    : task_runner(std::move(task_runner)) {}
+Scheduler::PerThreadState::PerThreadState(PerThreadState&& other) = default;
+Scheduler::PerThreadState::~PerThreadState() = default;
+Scheduler::PerThreadState& Scheduler::PerThreadState::operator=(
+    PerThreadState&& other) = default;
+
 Scheduler::Scheduler(scoped_refptr<base::SingleThreadTaskRunner> task_runner,
                      SyncPointManager* sync_point_manager,
                      const GpuPreferences& gpu_preferences)
     : task_runner_(std::move(task_runner)),
       sync_point_manager_(sync_point_manager),
+      foreign_thread_handle_(
+          base::MakeRefCounted<ForeignThreadHandle>(this)),
       blocked_time_collection_enabled_(
           gpu_preferences.enable_gpu_blocked_time_metric) {
   DCHECK(thread_checker_.CalledOnValidThread());
   // Store weak ptr separately because calling GetWeakPtr() is not thread safe.
   weak_ptr_ = weak_factory_.GetWeakPtr();
+  per_thread_state_map_.emplace(task_runner_.get(),
+                                PerThreadState(task_runner_));
 
   if (blocked_time_collection_enabled_ && !base::ThreadTicks::IsSupported()) {
     DLOG(ERROR) << "GPU Blocked time collection is enabled but not supported.";
@@ -312,15 +357,27 @@ Scheduler::Scheduler(scoped_refptr<base::SingleThreadTaskRunner> task_runner,
 
 Scheduler::~Scheduler() {
   DCHECK(thread_checker_.CalledOnValidThread());
+  foreign_thread_handle_->Invalidate();
 }
 
 SequenceId Scheduler::CreateSequence(SchedulingPriority priority) {
+  return CreateSequence(priority, task_runner_);
+}
+
+SequenceId Scheduler::CreateSequence(
+    SchedulingPriority priority,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+  DCHECK(task_runner);
   base::AutoLock auto_lock(lock_);
+  if (!per_thread_state_map_.contains(task_runner.get()))
+    per_thread_state_map_.emplace(task_runner.get(),
+                                  PerThreadState(task_runner));
   scoped_refptr<SyncPointOrderData> order_data =
       sync_point_manager_->CreateSyncPointOrderData();
   SequenceId sequence_id = order_data->sequence_id();
-  auto sequence = std::make_unique<Sequence>(this, sequence_id, priority,
-                                             std::move(order_data));
+  auto sequence =
+      std::make_unique<Sequence>(this, sequence_id, priority,
+                                 std::move(order_data), std::move(task_runner));
   sequences_.emplace(sequence_id, std::move(sequence));
   return sequence_id;
 }
@@ -331,7 +388,7 @@ void Scheduler::DestroySequence(SequenceId sequence_id) {
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
   if (sequence->scheduled())
-    rebuild_scheduling_queue_ = true;
+    GetPerThreadState(sequence->task_runner())->rebuild_scheduling_queue = true;
 
   sequences_.erase(sequence_id);
 }
@@ -344,6 +401,14 @@ Scheduler::Sequence* Scheduler::GetSequence(SequenceId sequence_id) {
   return nullptr;
 }
 
+Scheduler::PerThreadState* Scheduler::GetPerThreadState(
+    base::SingleThreadTaskRunner* task_runner) {
+  lock_.AssertAcquired();
+  auto it = per_thread_state_map_.find(task_runner);
+  DCHECK(it != per_thread_state_map_.end());
+  return &it->second;
+}
+
 void Scheduler::EnableSequence(SequenceId sequence_id) {
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
@@ -395,14 +460,28 @@ void Scheduler::ScheduleTaskHelper(Task task) {
 
   uint32_t order_num = sequence->ScheduleTask(std::move(task.closure));
 
+  // Fence releases are delivered on the waiting sequence's task runner, so
+  // that a sequence off the GPU thread does not wait for a busy GPU thread to
+  // learn that it can run.
+  scoped_refptr<base::SingleThreadTaskRunner> wait_task_runner =
+      sequence->task_runner();
   for (const SyncToken& sync_token : task.sync_token_fences) {
     SequenceId release_sequence_id =
         sync_point_manager_->GetSyncTokenReleaseSequenceId(sync_token);
+    base::OnceClosure release_callback = BindForTaskRunner(
+        wait_task_runner.get(),
+        base::BindOnce(
+            [](const SyncToken& sync_token, uint32_t order_num,
+               SequenceId release_sequence_id, SequenceId waiting_sequence_id,
+               Scheduler* scheduler) {
+              scheduler->SyncTokenFenceReleased(sync_token, order_num,
+                                                release_sequence_id,
+                                                waiting_sequence_id);
+            },
+            sync_token, order_num, release_sequence_id, sequence_id));
     if (sync_point_manager_->WaitNonThreadSafe(
-            sync_token, sequence_id, order_num, task_runner_,
-            base::BindOnce(&Scheduler::SyncTokenFenceReleased, weak_ptr_,
-                           sync_token, order_num, release_sequence_id,
-                           sequence_id))) {
+            sync_token, sequence_id, order_num, wait_task_runner,
+            std::move(release_callback))) {
       sequence->AddWaitFence(sync_token, order_num, release_sequence_id);
     }
   }
@@ -412,27 +491,31 @@ void Scheduler::ScheduleTaskHelper(Task task) {
 
 void Scheduler::ContinueTask(SequenceId sequence_id,
                              base::OnceClosure closure) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->ContinueTask(std::move(closure));
 }
 
 bool Scheduler::ShouldYield(SequenceId sequence_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
 
-  RebuildSchedulingQueue();
-
-  if (scheduling_queue_.empty())
-    return false;
-
   Sequence* running_sequence = GetSequence(sequence_id);
   DCHECK(running_sequence);
   DCHECK(running_sequence->running());
+  DCHECK(running_sequence->task_runner()->BelongsToCurrentThread());
 
-  Sequence* next_sequence = GetSequence(scheduling_queue_.front().sequence_id);
+  // Only sequences on the same thread compete for running time.
+  PerThreadState* thread_state =
+      GetPerThreadState(running_sequence->task_runner());
+  RebuildSchedulingQueue(thread_state);
+
+  if (thread_state->scheduling_queue.empty())
+    return false;
+
+  Sequence* next_sequence =
+      GetSequence(thread_state->scheduling_queue.front().sequence_id);
   DCHECK(next_sequence);
   DCHECK(next_sequence->scheduled());
 
@@ -457,67 +540,106 @@ void Scheduler::SyncTokenFenceReleased(const SyncToken& sync_token,
 void Scheduler::TryScheduleSequence(Sequence* sequence) {
   lock_.AssertAcquired();
 
+  PerThreadState* thread_state = GetPerThreadState(sequence->task_runner());
+
   if (sequence->running()) {
     // Update priority of running sequence because of sync token releases.
-    DCHECK(running_);
+    DCHECK(thread_state->running);
     sequence->UpdateRunningPriority();
   } else if (sequence->NeedsRescheduling()) {
     // Rebuild scheduling queue if priority changed for a scheduled sequence.
-    DCHECK(running_);
+    DCHECK(thread_state->running);
     DCHECK(sequence->IsRunnable());
-    rebuild_scheduling_queue_ = true;
+    thread_state->rebuild_scheduling_queue = true;
   } else if (!sequence->scheduled() && sequence->IsRunnable()) {
     // Insert into scheduling queue if sequence isn't already scheduled.
     SchedulingState scheduling_state = sequence->SetScheduled();
-    scheduling_queue_.push_back(scheduling_state);
-    std::push_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+    thread_state->scheduling_queue.push_back(scheduling_state);
+    std::push_heap(thread_state->scheduling_queue.begin(),
+                   thread_state->scheduling_queue.end(),
                    &SchedulingState::Comparator);
-    if (!running_) {
-      TRACE_EVENT_ASYNC_BEGIN0("gpu", "Scheduler::Running", this);
-      running_ = true;
-      task_runner_->PostTask(
-          FROM_HERE, base::BindOnce(&Scheduler::RunNextTask, weak_ptr_));
+    if (!thread_state->running) {
+      TRACE_EVENT_ASYNC_BEGIN0("gpu", "Scheduler::Running", thread_state);
+      thread_state->running = true;
+      PostRunNextTask(sequence->task_runner());
     }
   }
 }
 
-void Scheduler::RebuildSchedulingQueue() {
-  DCHECK(thread_checker_.CalledOnValidThread());
+void Scheduler::RebuildSchedulingQueue(PerThreadState* thread_state) {
+  DCHECK(thread_state->task_runner->BelongsToCurrentThread());
   lock_.AssertAcquired();
 
-  if (!rebuild_scheduling_queue_)
+  if (!thread_state->rebuild_scheduling_queue)
     return;
-  rebuild_scheduling_queue_ = false;
+  thread_state->rebuild_scheduling_queue = false;
 
-  scheduling_queue_.clear();
+  std::vector<SchedulingState>& scheduling_queue =
+      thread_state->scheduling_queue;
+  scheduling_queue.clear();
   for (const auto& kv : sequences_) {
     Sequence* sequence = kv.second.get();
-    if (!sequence->IsRunnable() || sequence->running())
+    if (sequence->task_runner() != thread_state->task_runner.get() ||
+        !sequence->IsRunnable() || sequence->running()) {
       continue;
+    }
     SchedulingState scheduling_state = sequence->SetScheduled();
-    scheduling_queue_.push_back(scheduling_state);
+    scheduling_queue.push_back(scheduling_state);
   }
 
-  std::make_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+  std::make_heap(scheduling_queue.begin(), scheduling_queue.end(),
                  &SchedulingState::Comparator);
 }
 
-void Scheduler::RunNextTask() {
-  DCHECK(thread_checker_.CalledOnValidThread());
+base::OnceClosure Scheduler::BindForTaskRunner(
+    base::SingleThreadTaskRunner* task_runner,
+    base::OnceCallback<void(Scheduler*)> callback) {
+  // |weak_ptr_| can only be dereferenced on the GPU thread.
+  if (task_runner == task_runner_.get()) {
+    return base::BindOnce(
+        [](base::WeakPtr<Scheduler> scheduler,
+           base::OnceCallback<void(Scheduler*)> callback) {
+          if (scheduler)
+            std::move(callback).Run(scheduler.get());
+        },
+        weak_ptr_, std::move(callback));
+  }
+  return base::BindOnce(&ForeignThreadHandle::RunIfAlive,
+                        foreign_thread_handle_, std::move(callback));
+}
+
+void Scheduler::PostRunNextTask(base::SingleThreadTaskRunner* task_runner) {
+  lock_.AssertAcquired();
+  task_runner->PostTask(
+      FROM_HERE,
+      BindForTaskRunner(task_runner,
+                        base::BindOnce(
+                            [](base::SingleThreadTaskRunner* task_runner,
+                               Scheduler* scheduler) {
+                              scheduler->RunNextTask(task_runner);
+                            },
+                            base::Unretained(task_runner))));
+}
+
+void Scheduler::RunNextTask(base::SingleThreadTaskRunner* task_runner) {
+  DCHECK(task_runner->BelongsToCurrentThread());
   base::AutoLock auto_lock(lock_);
 
-  RebuildSchedulingQueue();
+  PerThreadState* thread_state = GetPerThreadState(task_runner);
+  RebuildSchedulingQueue(thread_state);
 
-  if (scheduling_queue_.empty()) {
-    TRACE_EVENT_ASYNC_END0("gpu", "Scheduler::Running", this);
-    running_ = false;
+  std::vector<SchedulingState>& scheduling_queue =
+      thread_state->scheduling_queue;
+  if (scheduling_queue.empty()) {
+    TRACE_EVENT_ASYNC_END0("gpu", "Scheduler::Running", thread_state);
+    thread_state->running = false;
     return;
   }
 
-  std::pop_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+  std::pop_heap(scheduling_queue.begin(), scheduling_queue.end(),
                 &SchedulingState::Comparator);
-  SchedulingState state = scheduling_queue_.back();
-  scheduling_queue_.pop_back();
+  SchedulingState state = scheduling_queue.back();
+  scheduling_queue.pop_back();
 
   TRACE_EVENT1("gpu", "Scheduler::RunNextTask", "state", state.AsValue());
   base::ElapsedTimer task_timer;
@@ -532,6 +654,7 @@ void Scheduler::RunNextTask() {
   // Begin/FinishProcessingOrderNumber must be called with the lock released
   // because they can renter the scheduler in Enable/DisableSequence.
   scoped_refptr<SyncPointOrderData> order_data = sequence->order_data();
+  base::TimeDelta blocked_time;
   {
     base::AutoUnlock auto_unlock(lock_);
     order_data->BeginProcessingOrderNumber(order_num);
@@ -547,9 +670,7 @@ void Scheduler::RunNextTask() {
           base::ThreadTicks::Now() - thread_time_start;
       base::TimeDelta wall_time_elapsed =
           base::TimeTicks::Now() - wall_time_start;
-      base::TimeDelta blocked_time = wall_time_elapsed - thread_time_elapsed;
-
-      total_blocked_time_ += blocked_time;
+      blocked_time = wall_time_elapsed - thread_time_elapsed;
     } else {
       std::move(closure).Run();
     }
@@ -557,6 +678,11 @@ void Scheduler::RunNextTask() {
     if (order_data->IsProcessingOrderNumber())
       order_data->FinishProcessingOrderNumber(order_num);
   }
+  total_blocked_time_ += blocked_time;
+
+  // Sequences may have been created on new task runners while the lock was
+  // released, which invalidates pointers into |per_thread_state_map_|.
+  thread_state = GetPerThreadState(task_runner);
 
   // Check if sequence hasn't been destroyed.
   sequence = GetSequence(state.sequence_id);
@@ -564,8 +690,9 @@ void Scheduler::RunNextTask() {
     sequence->FinishTask();
     if (sequence->IsRunnable()) {
       SchedulingState scheduling_state = sequence->SetScheduled();
-      scheduling_queue_.push_back(scheduling_state);
-      std::push_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+      thread_state->scheduling_queue.push_back(scheduling_state);
+      std::push_heap(thread_state->scheduling_queue.begin(),
+                     thread_state->scheduling_queue.end(),
                      &SchedulingState::Comparator);
     }
   }
@@ -575,13 +702,13 @@ void Scheduler::RunNextTask() {
       base::TimeDelta::FromMicroseconds(10), base::TimeDelta::FromSeconds(30),
       100);
 
-  task_runner_->PostTask(FROM_HERE,
-                         base::BindOnce(&Scheduler::RunNextTask, weak_ptr_));
+  PostRunNextTask(task_runner);
 }
 
 base::TimeDelta Scheduler::TakeTotalBlockingTime() {
   if (!blocked_time_collection_enabled_ || !base::ThreadTicks::IsSupported())
     return base::TimeDelta::Min();
+  base::AutoLock auto_lock(lock_);
   base::TimeDelta result;
   std::swap(result, total_blocked_time_);
   return result;
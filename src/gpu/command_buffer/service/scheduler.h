@@ -15,6 +15,7 @@
 #include "base/gtest_prod_util.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/thread_checker.h"
 #include "gpu/command_buffer/common/command_buffer_id.h"
@@ -61,6 +62,19 @@ class GPU_EXPORT Scheduler {
   // Sequence could be created outside of GPU thread.
   SequenceId CreateSequence(SchedulingPriority priority);
 
+  // Create a sequence whose tasks run on |task_runner| instead of the GPU
+  // thread. Sequences on different task runners run in parallel and are only
+  // ordered by their sync token fences, so they must not share context state.
+  // Priorities are still propagated across task runners, but a sequence only
+  // yields to sequences on its own task runner. Sync token fence releases for
+  // the sequence are also delivered on |task_runner|, so it does not wait on
+  // a busy GPU thread. The scheduler's tasks left on |task_runner| when it is
+  // destroyed do nothing, and its destructor waits for one that is already
+  // running to return, so such a task must not wait for the GPU thread.
+  SequenceId CreateSequence(
+      SchedulingPriority priority,
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+
   // Destroy the sequence and run any scheduled tasks immediately. Sequence
   // could be destroyed outside of GPU thread.
   void DestroySequence(SequenceId sequence_id);
@@ -131,12 +145,17 @@ class GPU_EXPORT Scheduler {
     Sequence(Scheduler* scheduler,
              SequenceId sequence_id,
              SchedulingPriority priority,
-             scoped_refptr<SyncPointOrderData> order_data);
+             scoped_refptr<SyncPointOrderData> order_data,
+             scoped_refptr<base::SingleThreadTaskRunner> task_runner);
 
     ~Sequence();
 
     SequenceId sequence_id() const { return sequence_id_; }
 
+    base::SingleThreadTaskRunner* task_runner() const {
+      return task_runner_.get();
+    }
+
     const scoped_refptr<SyncPointOrderData>& order_data() const {
       return order_data_;
     }
@@ -287,6 +306,9 @@ class GPU_EXPORT Scheduler {
 
     scoped_refptr<SyncPointOrderData> order_data_;
 
+    // Task runner the tasks of this sequence run on.
+    const scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
+
     // Deque of tasks. Tasks are inserted at the back with increasing order
     // number generated from SyncPointOrderData. If a running task needs to be
     // continued, it is inserted at the front with the same order number.
@@ -307,6 +329,55 @@ class GPU_EXPORT Scheduler {
     DISALLOW_COPY_AND_ASSIGN(Sequence);
   };
 
+  // Lets tasks posted to task runners other than |task_runner_| find out
+  // whether the scheduler is still alive, as |weak_ptr_| can only be
+  // dereferenced on the GPU thread.
+  class ForeignThreadHandle
+      : public base::RefCountedThreadSafe<ForeignThreadHandle> {
+   public:
+    explicit ForeignThreadHandle(Scheduler* scheduler);
+
+    // Runs |callback| with the scheduler, unless Invalidate() was called.
+    void RunIfAlive(base::OnceCallback<void(Scheduler*)> callback);
+
+    // Called by ~Scheduler(). Returns once no RunIfAlive() call is running.
+    void Invalidate();
+
+   private:
+    friend class base::RefCountedThreadSafe<ForeignThreadHandle>;
+    ~ForeignThreadHandle();
+
+    base::Lock lock_;
+    base::ConditionVariable no_running_callbacks_;
+    // Protected by |lock_|.
+    Scheduler* scheduler_;
+    int running_callbacks_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(ForeignThreadHandle);
+  };
+
+  // Scheduling state of the sequences running on one task runner.
+  struct PerThreadState {
+    explicit PerThreadState(
+        scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+    PerThreadState(PerThreadState&& other);
+    ~PerThreadState();
+    PerThreadState& operator=(PerThreadState&& other);
+
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner;
+
+    // Used as a priority queue for scheduling sequences. Min heap of
+    // SchedulingState with highest priority (lowest order) in front.
+    std::vector<SchedulingState> scheduling_queue;
+
+    // If the scheduling queue needs to be rebuild because a sequence changed
+    // priority.
+    bool rebuild_scheduling_queue = false;
+
+    // If a RunNextTask() call is pending or in progress on |task_runner|.
+    bool running = false;
+  };
+
   void SyncTokenFenceReleased(const SyncToken& sync_token,
                               uint32_t order_num,
                               SequenceId release_sequence_id,
@@ -316,11 +387,21 @@ class GPU_EXPORT Scheduler {
 
   void TryScheduleSequence(Sequence* sequence);
 
-  void RebuildSchedulingQueue();
+  void RebuildSchedulingQueue(PerThreadState* thread_state);
 
   Sequence* GetSequence(SequenceId sequence_id);
 
-  void RunNextTask();
+  PerThreadState* GetPerThreadState(base::SingleThreadTaskRunner* task_runner);
+
+  // Returns a closure, to be posted to |task_runner|, which runs |callback|
+  // unless the scheduler was destroyed.
+  base::OnceClosure BindForTaskRunner(
+      base::SingleThreadTaskRunner* task_runner,
+      base::OnceCallback<void(Scheduler*)> callback);
+
+  void PostRunNextTask(base::SingleThreadTaskRunner* task_runner);
+
+  void RunNextTask(base::SingleThreadTaskRunner* task_runner);
 
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
@@ -329,24 +410,22 @@ class GPU_EXPORT Scheduler {
   mutable base::Lock lock_;
 
   // The following are protected by |lock_|.
-  bool running_ = false;
-
   base::flat_map<SequenceId, std::unique_ptr<Sequence>> sequences_;
 
-  // Used as a priority queue for scheduling sequences. Min heap of
-  // SchedulingState with highest priority (lowest order) in front.
-  std::vector<SchedulingState> scheduling_queue_;
-
-  // If the scheduling queue needs to be rebuild because a sequence changed
-  // priority.
-  bool rebuild_scheduling_queue_ = false;
+  // Scheduling state for each task runner that sequences run on, including
+  // |task_runner_|.
+  base::flat_map<base::SingleThreadTaskRunner*, PerThreadState>
+      per_thread_state_map_;
 
-  // Accumulated time the thread was blocked during running task
+  // Accumulated time the threads were blocked during running task
   base::TimeDelta total_blocked_time_;
   const bool blocked_time_collection_enabled_;
 
   base::ThreadChecker thread_checker_;
 
+  // Shared with the tasks posted to task runners other than |task_runner_|.
+  scoped_refptr<ForeignThreadHandle> foreign_thread_handle_;
+
   // Invalidated on main thread.
   base::WeakPtr<Scheduler> weak_ptr_;
   base::WeakPtrFactory<Scheduler> weak_factory_{this};
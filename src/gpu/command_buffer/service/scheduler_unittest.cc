@@ -43,6 +43,8 @@ class SchedulerTest : public testing::Test {
 
   Scheduler* scheduler() const { return scheduler_.get(); }
 
+  void DestroyScheduler() { scheduler_.reset(); }
+
  private:
   scoped_refptr<base::TestSimpleTaskRunner> task_runner_;
   std::unique_ptr<SyncPointManager> sync_point_manager_;
@@ -524,6 +526,132 @@ TEST_F(SchedulerTest, ReentrantEnableSequenceShouldNotDeadlock) {
   release_state2->Destroy();
 }
 
+TEST_F(SchedulerTest, SequencesOnOtherTaskRunnerRunInParallel) {
+  auto other_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kLow);
+  SequenceId sequence_id2 = scheduler()->CreateSequence(
+      SchedulingPriority::kHigh, other_task_runner);
+
+  // The low priority sequence does not yield to a sequence on another task
+  // runner, and the high priority sequence does not wait for it.
+  bool ran1 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id1, GetClosure([&] {
+        EXPECT_FALSE(scheduler()->ShouldYield(sequence_id1));
+        ran1 = true;
+      }),
+      std::vector<SyncToken>()));
+
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] { ran2 = true; }), std::vector<SyncToken>()));
+
+  EXPECT_TRUE(task_runner()->HasPendingTask());
+  EXPECT_TRUE(other_task_runner->HasPendingTask());
+
+  other_task_runner->RunPendingTasks();
+  EXPECT_FALSE(ran1);
+  EXPECT_TRUE(ran2);
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+}
+
+TEST_F(SchedulerTest, TaskOnOtherTaskRunnerOutlivesScheduler) {
+  auto other_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  SequenceId sequence_id = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, other_task_runner);
+
+  bool ran = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id, GetClosure([&] { ran = true; }), std::vector<SyncToken>()));
+  EXPECT_TRUE(other_task_runner->HasPendingTask());
+
+  // The scheduler's task left on the other task runner does nothing.
+  DestroyScheduler();
+  other_task_runner->RunPendingTasks();
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(SchedulerTest, SequenceWaitsForFenceOnOtherTaskRunner) {
+  auto other_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  CommandBufferNamespace namespace_id = CommandBufferNamespace::GPU_IO;
+  CommandBufferId command_buffer_id = CommandBufferId::FromUnsafeValue(1);
+  scoped_refptr<SyncPointClientState> release_state =
+      sync_point_manager()->CreateSyncPointClientState(
+          namespace_id, command_buffer_id, sequence_id1);
+  SequenceId sequence_id2 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, other_task_runner);
+
+  uint64_t release = 1;
+  SyncToken sync_token(namespace_id, command_buffer_id, release);
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] { ran2 = true; }), {sync_token}));
+  EXPECT_FALSE(other_task_runner->HasPendingTask());
+
+  bool ran1 = false;
+  scheduler()->ScheduleTask(
+      Scheduler::Task(sequence_id1, GetClosure([&] {
+                        release_state->ReleaseFenceSync(release);
+                        ran1 = true;
+                      }),
+                      std::vector<SyncToken>()));
+
+  // The fence release is delivered on the waiting sequence's own task runner,
+  // which then runs the waiting sequence without involving the GPU thread.
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+  EXPECT_FALSE(ran2);
+  EXPECT_FALSE(task_runner()->HasPendingTask());
+  EXPECT_TRUE(other_task_runner->HasPendingTask());
+
+  other_task_runner->RunUntilIdle();
+  EXPECT_TRUE(ran2);
+
+  release_state->Destroy();
+}
+
+// Sequences off the GPU thread which wait on each other's fences make progress
+// while the GPU thread is busy.
+TEST_F(SchedulerTest, FenceOnOtherTaskRunnerDoesNotNeedGpuThread) {
+  auto other_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  SequenceId sequence_id1 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, other_task_runner);
+  CommandBufferNamespace namespace_id = CommandBufferNamespace::GPU_IO;
+  CommandBufferId command_buffer_id = CommandBufferId::FromUnsafeValue(1);
+  scoped_refptr<SyncPointClientState> release_state =
+      sync_point_manager()->CreateSyncPointClientState(
+          namespace_id, command_buffer_id, sequence_id1);
+  SequenceId sequence_id2 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, other_task_runner);
+
+  uint64_t release = 1;
+  SyncToken sync_token(namespace_id, command_buffer_id, release);
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] { ran2 = true; }), {sync_token}));
+
+  bool ran1 = false;
+  scheduler()->ScheduleTask(
+      Scheduler::Task(sequence_id1, GetClosure([&] {
+                        release_state->ReleaseFenceSync(release);
+                        ran1 = true;
+                      }),
+                      std::vector<SyncToken>()));
+
+  // The GPU thread's task runner is never run.
+  other_task_runner->RunUntilIdle();
+  EXPECT_TRUE(ran1);
+  EXPECT_TRUE(ran2);
+  EXPECT_FALSE(task_runner()->HasPendingTask());
+
+  release_state->Destroy();
+}
+
 TEST_F(SchedulerTest, ClientWaitIsPrioritized) {
   SequenceId sequence_id1 =
       scheduler()->CreateSequence(SchedulingPriority::kNormal);
@@ -165,11 +165,7 @@ bool ServiceTransferCache::CreateLockedEntry(const EntryKey& key,
   if (!entry->Deserialize(context, data))
     return false;
 
-  total_size_ += entry->CachedSize();
-  if (key.entry_type == cc::TransferCacheEntryType::kImage) {
-    total_image_count_++;
-    total_image_size_ += entry->CachedSize();
-  }
+  AddEntrySize(key, entry->CachedSize());
   entries_.Put(key, CacheEntryInternal(handle, std::move(entry)));
   EnforceLimits();
   return true;
@@ -184,11 +180,7 @@ void ServiceTransferCache::CreateLocalEntry(
   DCHECK_EQ(entry->Type(), key.entry_type);
   DeleteEntry(key);
 
-  total_size_ += entry->CachedSize();
-  if (key.entry_type == cc::TransferCacheEntryType::kImage) {
-    total_image_count_++;
-    total_image_size_ += entry->CachedSize();
-  }
+  AddEntrySize(key, entry->CachedSize());
 
   entries_.Put(key, CacheEntryInternal(base::nullopt, std::move(entry)));
   EnforceLimits();
@@ -210,13 +202,35 @@ Iterator ServiceTransferCache::ForceDeleteEntry(Iterator it) {
   if (it->second.handle)
     it->second.handle->ForceDelete();
 
-  DCHECK_GE(total_size_, it->second.entry->CachedSize());
-  total_size_ -= it->second.entry->CachedSize();
-  if (it->first.entry_type == cc::TransferCacheEntryType::kImage) {
+  RemoveEntrySize(it->first, it->second.entry->CachedSize());
+  return entries_.Erase(it);
+}
+
+void ServiceTransferCache::AddEntrySize(const EntryKey& key, size_t size) {
+  total_size_ += size;
+  if (key.entry_type == cc::TransferCacheEntryType::kImage) {
+    total_image_count_++;
+    total_image_size_ += size;
+  }
+  if (size)
+    decoder_sizes_[key.decoder_id] += size;
+}
+
+void ServiceTransferCache::RemoveEntrySize(const EntryKey& key, size_t size) {
+  DCHECK_GE(total_size_, size);
+  total_size_ -= size;
+  if (key.entry_type == cc::TransferCacheEntryType::kImage) {
     total_image_count_--;
-    total_image_size_ -= it->second.entry->CachedSize();
+    total_image_size_ -= size;
   }
-  return entries_.Erase(it);
+  if (!size)
+    return;
+  auto it = decoder_sizes_.find(key.decoder_id);
+  DCHECK(it != decoder_sizes_.end());
+  DCHECK_GE(it->second, size);
+  it->second -= size;
+  if (!it->second)
+    decoder_sizes_.erase(it);
 }
 
 bool ServiceTransferCache::DeleteEntry(const EntryKey& key) {
@@ -230,30 +244,61 @@ bool ServiceTransferCache::DeleteEntry(const EntryKey& key) {
 
 cc::ServiceTransferCacheEntry* ServiceTransferCache::GetEntry(
     const EntryKey& key) {
+  EntryTypeStats& stats = entry_type_stats_[key.entry_type];
   auto found = entries_.Get(key);
-  if (found == entries_.end())
+  if (found == entries_.end()) {
+    stats.misses++;
     return nullptr;
+  }
+  stats.hits++;
   return found->second.entry.get();
 }
 
+ServiceTransferCache::EntryTypeStats ServiceTransferCache::GetStatsForEntryType(
+    cc::TransferCacheEntryType entry_type) const {
+  auto it = entry_type_stats_.find(entry_type);
+  return it == entry_type_stats_.end() ? EntryTypeStats() : it->second;
+}
+
+bool ServiceTransferCache::OverLimits() const {
+  return total_size_ > cache_size_limit_ ||
+         entries_.size() > max_cache_entries_;
+}
+
+ServiceTransferCache::EntryCache::reverse_iterator
+ServiceTransferCache::EvictEntry(EntryCache::reverse_iterator it) {
+  if (it->second.handle && !it->second.handle->Delete())
+    return ++it;
+
+  size_t size = it->second.entry->CachedSize();
+  EntryTypeStats& stats = entry_type_stats_[it->first.entry_type];
+  stats.evictions++;
+  stats.evicted_bytes += size;
+  RemoveEntrySize(it->first, size);
+  return entries_.Erase(it);
+}
+
 void ServiceTransferCache::EnforceLimits() {
-  for (auto it = entries_.rbegin(); it != entries_.rend();) {
-    if (total_size_ <= cache_size_limit_ &&
-        entries_.size() <= max_cache_entries_) {
-      return;
-    }
-    if (it->second.handle && !it->second.handle->Delete()) {
-      ++it;
-      continue;
-    }
+  if (!OverLimits())
+    return;
 
-    total_size_ -= it->second.entry->CachedSize();
-    if (it->first.entry_type == cc::TransferCacheEntryType::kImage) {
-      total_image_count_--;
-      total_image_size_ -= it->second.entry->CachedSize();
+  // When several decoders share the cache, first evict from the ones using
+  // more than an even share of it, oldest entries first.
+  if (decoder_sizes_.size() > 1) {
+    const size_t fair_share = cache_size_limit_ / decoder_sizes_.size();
+    for (auto it = entries_.rbegin(); it != entries_.rend() && OverLimits();) {
+      auto decoder_size = decoder_sizes_.find(it->first.decoder_id);
+      if (decoder_size == decoder_sizes_.end() ||
+          decoder_size->second <= fair_share) {
+        ++it;
+        continue;
+      }
+      it = EvictEntry(it);
     }
-    it = entries_.Erase(it);
   }
+
+  for (auto it = entries_.rbegin(); it != entries_.rend() && OverLimits();)
+    it = EvictEntry(it);
 }
 
 void ServiceTransferCache::PurgeMemory(
@@ -298,11 +343,7 @@ bool ServiceTransferCache::CreateLockedHardwareDecodedImageEntry(
   }
 
   // Insert it in the transfer cache.
-  total_size_ += entry->CachedSize();
-  if (key.entry_type == cc::TransferCacheEntryType::kImage) {
-    total_image_count_++;
-    total_image_size_ += entry->CachedSize();
-  }
+  AddEntrySize(key, entry->CachedSize());
   entries_.Put(key, CacheEntryInternal(handle, std::move(entry)));
   EnforceLimits();
   return true;
@@ -335,6 +376,21 @@ bool ServiceTransferCache::OnMemoryDump(
     return true;
   }
 
+  for (const auto& type_and_stats : entry_type_stats_) {
+    const EntryTypeStats& stats = type_and_stats.second;
+    MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(base::StringPrintf(
+        "gpu/transfer_cache/cache_0x%" PRIXPTR "/stats/type_%u",
+        reinterpret_cast<uintptr_t>(this),
+        static_cast<uint32_t>(type_and_stats.first)));
+    dump->AddScalar("hits", MemoryAllocatorDump::kUnitsObjects, stats.hits);
+    dump->AddScalar("misses", MemoryAllocatorDump::kUnitsObjects,
+                    stats.misses);
+    dump->AddScalar("evictions", MemoryAllocatorDump::kUnitsObjects,
+                    stats.evictions);
+    dump->AddScalar("evicted_bytes", MemoryAllocatorDump::kUnitsBytes,
+                    stats.evicted_bytes);
+  }
+
   for (auto it = entries_.begin(); it != entries_.end(); it++) {
     auto entry_type = it->first.entry_type;
     const auto* entry = it->second.entry.get();
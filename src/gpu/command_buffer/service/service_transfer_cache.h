@@ -11,6 +11,7 @@
 #include <memory>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/containers/mru_cache.h"
 #include "base/containers/span.h"
 #include "base/memory/memory_pressure_listener.h"
@@ -35,7 +36,9 @@ namespace gpu {
 // In addition to access, the ServiceTransferCache is also responsible for
 // unlocking and deleting entries when no longer needed, as well as enforcing
 // cache limits. If the cache exceeds its specified limits, unlocked transfer
-// cache entries may be deleted.
+// cache entries may be deleted. Eviction first targets the least recently used
+// entries of decoders holding more than an even share of the cache, so that a
+// single busy client can't push out the working set of all other clients.
 class GPU_GLES2_EXPORT ServiceTransferCache
     : public base::trace_event::MemoryDumpProvider {
  public:
@@ -48,6 +51,14 @@ class GPU_GLES2_EXPORT ServiceTransferCache
     uint32_t entry_id;
   };
 
+  // Cache activity for a single entry type, reported in detailed memory dumps.
+  struct EntryTypeStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    uint64_t evicted_bytes = 0;
+  };
+
   explicit ServiceTransferCache(const GpuPreferences& preferences);
   ~ServiceTransferCache() override;
 
@@ -82,6 +93,10 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   void PurgeMemory(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
+  // Returns the hit, miss and eviction counts accumulated for |entry_type|.
+  EntryTypeStats GetStatsForEntryType(
+      cc::TransferCacheEntryType entry_type) const;
+
   // base::trace_event::MemoryDumpProvider implementation.
   bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
                     base::trace_event::ProcessMemoryDump* pmd) override;
@@ -97,6 +112,10 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   }
   size_t cache_size_for_testing() const { return total_size_; }
   size_t entries_count_for_testing() const { return entries_.size(); }
+  size_t decoder_cache_size_for_testing(int decoder_id) const {
+    auto it = decoder_sizes_.find(decoder_id);
+    return it == decoder_sizes_.end() ? 0u : it->second;
+  }
 
  private:
   struct CacheEntryInternal {
@@ -122,10 +141,20 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   using EntryCache = base::MRUCache<EntryKey, CacheEntryInternal, EntryKeyComp>;
 
   void EnforceLimits();
+  bool OverLimits() const;
+
+  // Evicts the entry at |it| unless it is locked. Returns the iterator to the
+  // next entry to consider.
+  EntryCache::reverse_iterator EvictEntry(EntryCache::reverse_iterator it);
 
   template <typename Iterator>
   Iterator ForceDeleteEntry(Iterator it);
 
+  // Update the size bookkeeping when an entry is added to or removed from
+  // |entries_|.
+  void AddEntrySize(const EntryKey& key, size_t size);
+  void RemoveEntrySize(const EntryKey& key, size_t size);
+
   EntryCache entries_;
 
   // Total size of all |entries_|. The same as summing
@@ -136,6 +165,12 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   // Number of |entries_| of TransferCacheEntryType::kImage.
   int total_image_count_ = 0;
 
+  // Total size of the |entries_| owned by each decoder. Decoders without
+  // entries are not present.
+  base::flat_map<int, size_t> decoder_sizes_;
+
+  base::flat_map<cc::TransferCacheEntryType, EntryTypeStats> entry_type_stats_;
+
   // The limit above which the cache will start evicting resources.
   size_t cache_size_limit_;
 
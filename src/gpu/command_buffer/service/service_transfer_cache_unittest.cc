@@ -112,5 +112,76 @@ TEST(ServiceTransferCache, DeleteEntriesForDecoder) {
             nullptr);
 }
 
+TEST(ServiceTransferCache, EvictsFromDecoderOverFairShare) {
+  ServiceTransferCache cache{GpuPreferences()};
+  const size_t entry_size = 1024u;
+  cache.SetCacheSizeLimitForTesting(4 * entry_size);
+
+  // Decoder 1 adds a single entry, which is the least recently used one.
+  cache.CreateLocalEntry(ServiceTransferCache::EntryKey(1, kEntryType, 1),
+                         CreateEntry(entry_size));
+
+  // Decoder 2 keeps adding entries, as a page raster storm would.
+  for (uint32_t i = 1; i <= 6; ++i) {
+    cache.CreateLocalEntry(ServiceTransferCache::EntryKey(2, kEntryType, i),
+                           CreateEntry(entry_size));
+  }
+
+  // Eviction was paid for by decoder 2, which is over its share of the cache.
+  EXPECT_EQ(cache.cache_size_for_testing(), 4 * entry_size);
+  EXPECT_EQ(cache.decoder_cache_size_for_testing(1), entry_size);
+  EXPECT_EQ(cache.decoder_cache_size_for_testing(2), 3 * entry_size);
+  EXPECT_NE(cache.GetEntry(ServiceTransferCache::EntryKey(1, kEntryType, 1)),
+            nullptr);
+  EXPECT_EQ(cache.GetEntry(ServiceTransferCache::EntryKey(2, kEntryType, 3)),
+            nullptr);
+  EXPECT_NE(cache.GetEntry(ServiceTransferCache::EntryKey(2, kEntryType, 4)),
+            nullptr);
+
+  // Once decoder 1 is gone, decoder 2 can use the whole cache again.
+  cache.DeleteAllEntriesForDecoder(1);
+  EXPECT_EQ(cache.decoder_cache_size_for_testing(1), 0u);
+  cache.CreateLocalEntry(ServiceTransferCache::EntryKey(2, kEntryType, 7),
+                         CreateEntry(entry_size));
+  EXPECT_EQ(cache.decoder_cache_size_for_testing(2), 4 * entry_size);
+}
+
+TEST(ServiceTransferCache, TracksStatsPerEntryType) {
+  ServiceTransferCache cache{GpuPreferences()};
+  const size_t entry_size = 1024u;
+  cache.SetCacheSizeLimitForTesting(2 * entry_size);
+
+  // Simulate a few raster passes that reuse the same two entries.
+  for (uint32_t id = 1; id <= 2; ++id) {
+    ServiceTransferCache::EntryKey key(kDecoderId, kEntryType, id);
+    EXPECT_EQ(cache.GetEntry(key), nullptr);
+    cache.CreateLocalEntry(key, CreateEntry(entry_size));
+  }
+  for (int pass = 0; pass < 3; ++pass) {
+    for (uint32_t id = 1; id <= 2; ++id) {
+      EXPECT_NE(
+          cache.GetEntry(ServiceTransferCache::EntryKey(kDecoderId, kEntryType,
+                                                        id)),
+          nullptr);
+    }
+  }
+
+  // A new entry pushes out the least recently used one.
+  cache.CreateLocalEntry(
+      ServiceTransferCache::EntryKey(kDecoderId, kEntryType, 3),
+      CreateEntry(entry_size));
+
+  ServiceTransferCache::EntryTypeStats stats =
+      cache.GetStatsForEntryType(kEntryType);
+  EXPECT_EQ(stats.hits, 6u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.evicted_bytes, entry_size);
+
+  stats = cache.GetStatsForEntryType(cc::TransferCacheEntryType::kImage);
+  EXPECT_EQ(stats.hits, 0u);
+  EXPECT_EQ(stats.evictions, 0u);
+}
+
 }  // namespace
 }  // namespace gpu
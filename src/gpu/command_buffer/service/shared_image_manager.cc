@@ -55,7 +55,8 @@ class SCOPED_LOCKABLE SharedImageManager::AutoLock {
  public:
   explicit AutoLock(SharedImageManager* manager)
       EXCLUSIVE_LOCK_FUNCTION(manager->lock_)
-      : start_time_(base::TimeTicks::Now()),
+      : start_time_(manager->is_thread_safe() ? base::TimeTicks::Now()
+                                              : base::TimeTicks()),
         auto_lock_(manager->is_thread_safe() ? &manager->lock_.value()
                                              : nullptr) {
     if (manager->is_thread_safe()) {
@@ -112,10 +112,9 @@ bool StringMismatch(const std::string& input, const std::string& pattern) {
 }
 
 bool StringMismatch(const std::string& input, const char* pattern) {
-  if (!pattern)
+  if (!pattern || !*pattern || input.empty())
     return false;
-  std::string pattern_string(pattern);
-  return StringMismatch(input, pattern_string);
+  return !RE2::FullMatch(input, pattern);
 }
 
 }  // namespace
@@ -370,44 +369,46 @@ bool GpuControlList::Conditions::Contains(OsType target_os_type,
                                           const std::string& target_os_version,
                                           const GPUInfo& gpu_info) const {
   DCHECK(target_os_type != kOsAny);
-  if (os_type != kOsAny) {
-    if (os_type != target_os_type)
-      return false;
-    if (os_version.IsSpecified() && !os_version.Contains(target_os_version))
-      return false;
-  }
+  if (os_type != kOsAny && os_type != target_os_type)
+    return false;
+  // The GPU checks below only compare integers, so run them before parsing
+  // any version strings; most entries are rejected by vendor or device.
   if (vendor_id != 0 || intel_gpu_series_list_size > 0 ||
       intel_gpu_generation.IsSpecified()) {
-    std::vector<GPUInfo::GPUDevice> candidates;
+    // Point at the devices rather than copying them, as GPUDevice holds
+    // several strings.
+    std::vector<const GPUInfo::GPUDevice*> candidates;
     switch (multi_gpu_category) {
       case kMultiGpuCategoryPrimary:
-        candidates.push_back(gpu_info.gpu);
+        candidates.push_back(&gpu_info.gpu);
         break;
       case kMultiGpuCategorySecondary:
-        candidates = gpu_info.secondary_gpus;
+        for (const auto& secondary_gpu : gpu_info.secondary_gpus)
+          candidates.push_back(&secondary_gpu);
         break;
       case kMultiGpuCategoryAny:
-        candidates = gpu_info.secondary_gpus;
-        candidates.push_back(gpu_info.gpu);
+        for (const auto& secondary_gpu : gpu_info.secondary_gpus)
+          candidates.push_back(&secondary_gpu);
+        candidates.push_back(&gpu_info.gpu);
         break;
       case kMultiGpuCategoryActive:
       case kMultiGpuCategoryNone:
         // If gpu category is not specified, default to the active gpu.
         if (gpu_info.gpu.active || gpu_info.secondary_gpus.empty())
-          candidates.push_back(gpu_info.gpu);
+          candidates.push_back(&gpu_info.gpu);
         for (size_t ii = 0; ii < gpu_info.secondary_gpus.size(); ++ii) {
           if (gpu_info.secondary_gpus[ii].active)
-            candidates.push_back(gpu_info.secondary_gpus[ii]);
+            candidates.push_back(&gpu_info.secondary_gpus[ii]);
         }
         if (candidates.empty())
-          candidates.push_back(gpu_info.gpu);
+          candidates.push_back(&gpu_info.gpu);
     }
 
     bool found = false;
     if (intel_gpu_series_list_size > 0) {
       for (size_t ii = 0; !found && ii < candidates.size(); ++ii) {
         IntelGpuSeriesType candidate_series = GetIntelGpuSeriesType(
-            candidates[ii].vendor_id, candidates[ii].device_id);
+            candidates[ii]->vendor_id, candidates[ii]->device_id);
         if (candidate_series == IntelGpuSeriesType::kUnknown)
           continue;
         for (size_t jj = 0; jj < intel_gpu_series_list_size; ++jj) {
@@ -420,7 +421,7 @@ bool GpuControlList::Conditions::Contains(OsType target_os_type,
     } else if (intel_gpu_generation.IsSpecified()) {
       for (size_t ii = 0; ii < candidates.size(); ++ii) {
         std::string candidate_generation = GetIntelGpuGeneration(
-            candidates[ii].vendor_id, candidates[ii].device_id);
+            candidates[ii]->vendor_id, candidates[ii]->device_id);
         if (candidate_generation.empty())
           continue;
         if (intel_gpu_generation.Contains(candidate_generation)) {
@@ -429,31 +430,28 @@ bool GpuControlList::Conditions::Contains(OsType target_os_type,
         }
       }
     } else {
-      GPUInfo::GPUDevice gpu;
-      gpu.vendor_id = vendor_id;
-      if (device_id_size == 0) {
-        for (size_t ii = 0; ii < candidates.size(); ++ii) {
-          if (gpu.vendor_id == candidates[ii].vendor_id) {
+      for (size_t ii = 0; !found && ii < candidates.size(); ++ii) {
+        if (vendor_id != candidates[ii]->vendor_id)
+          continue;
+        if (device_id_size == 0) {
+          found = true;
+          break;
+        }
+        for (size_t jj = 0; jj < device_id_size; ++jj) {
+          if (device_ids[jj] == candidates[ii]->device_id) {
             found = true;
             break;
           }
         }
-      } else {
-        for (size_t ii = 0; ii < device_id_size; ++ii) {
-          gpu.device_id = device_ids[ii];
-          for (size_t jj = 0; jj < candidates.size(); ++jj) {
-            if (gpu.vendor_id == candidates[jj].vendor_id &&
-                gpu.device_id == candidates[jj].device_id) {
-              found = true;
-              break;
-            }
-          }
-        }
       }
     }
     if (!found)
       return false;
   }
+  if (os_type != kOsAny && os_version.IsSpecified() &&
+      !os_version.Contains(target_os_version)) {
+    return false;
+  }
   switch (multi_gpu_style) {
     case kMultiGpuStyleOptimus:
       if (!gpu_info.optimus)
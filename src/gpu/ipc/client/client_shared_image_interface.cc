@@ -15,9 +15,10 @@ ClientSharedImageInterface::ClientSharedImageInterface(
 
 ClientSharedImageInterface::~ClientSharedImageInterface() {
   gpu::SyncToken sync_token;
-  auto mailboxes_to_delete = mailboxes_;
-  for (const auto& mailbox : mailboxes_to_delete)
-    DestroySharedImage(sync_token, mailbox);
+  std::vector<Mailbox> mailboxes_to_delete(mailboxes_.begin(),
+                                           mailboxes_.end());
+  if (!mailboxes_to_delete.empty())
+    DestroySharedImages(sync_token, mailboxes_to_delete);
 }
 
 void ClientSharedImageInterface::UpdateSharedImage(const SyncToken& sync_token,
@@ -120,6 +121,20 @@ void ClientSharedImageInterface::DestroySharedImage(const SyncToken& sync_token,
   proxy_->DestroySharedImage(sync_token, mailbox);
 }
 
+void ClientSharedImageInterface::DestroySharedImages(
+    const SyncToken& sync_token,
+    const std::vector<Mailbox>& mailboxes) {
+  {
+    base::AutoLock lock(lock_);
+    for (const auto& mailbox : mailboxes) {
+      DCHECK(!mailbox.IsZero());
+      DCHECK_NE(mailboxes_.count(mailbox), 0u);
+      mailboxes_.erase(mailbox);
+    }
+  }
+  proxy_->DestroySharedImages(sync_token, mailboxes);
+}
+
 uint32_t ClientSharedImageInterface::UsageForMailbox(const Mailbox& mailbox) {
   return proxy_->UsageForMailbox(mailbox);
 }
@@ -61,6 +61,8 @@ class GPU_EXPORT ClientSharedImageInterface : public SharedImageInterface {
                                      uint32_t usage) override;
   void DestroySharedImage(const SyncToken& sync_token,
                           const Mailbox& mailbox) override;
+  void DestroySharedImages(const SyncToken& sync_token,
+                           const std::vector<Mailbox>& mailboxes) override;
   uint32_t UsageForMailbox(const Mailbox& mailbox) override;
 
  private:
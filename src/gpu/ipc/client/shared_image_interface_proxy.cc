@@ -48,6 +48,25 @@ void* GetDataAddress(const base::MappedReadOnlyRegion& region,
   return region.mapping.GetMemoryAs<uint8_t>() + offset;
 }
 
+std::vector<SyncToken> GenerateDependenciesFromSyncToken(
+    const SyncToken& sync_token,
+    GpuChannelHost* host) {
+  std::vector<SyncToken> dependencies;
+  if (sync_token.HasData()) {
+    dependencies.push_back(sync_token);
+    SyncToken& new_token = dependencies.back();
+    if (!new_token.verified_flush()) {
+      // Only allow unverified sync tokens for the same channel.
+      DCHECK_EQ(sync_token.namespace_id(), gpu::CommandBufferNamespace::GPU_IO);
+      int sync_token_channel_id =
+          ChannelIdFromCommandBufferId(sync_token.command_buffer_id());
+      DCHECK_EQ(sync_token_channel_id, host->channel_id());
+      new_token.SetVerifyFlush();
+    }
+  }
+  return dependencies;
+}
+
 }  // namespace
 
 SharedImageInterfaceProxy::SharedImageInterfaceProxy(GpuChannelHost* host,
@@ -219,19 +238,8 @@ void SharedImageInterfaceProxy::UpdateSharedImage(
 
 void SharedImageInterfaceProxy::DestroySharedImage(const SyncToken& sync_token,
                                                    const Mailbox& mailbox) {
-  std::vector<SyncToken> dependencies;
-  if (sync_token.HasData()) {
-    dependencies.push_back(sync_token);
-    SyncToken& new_token = dependencies.back();
-    if (!new_token.verified_flush()) {
-      // Only allow unverified sync tokens for the same channel.
-      DCHECK_EQ(sync_token.namespace_id(), gpu::CommandBufferNamespace::GPU_IO);
-      int sync_token_channel_id =
-          ChannelIdFromCommandBufferId(sync_token.command_buffer_id());
-      DCHECK_EQ(sync_token_channel_id, host_->channel_id());
-      new_token.SetVerifyFlush();
-    }
-  }
+  std::vector<SyncToken> dependencies =
+      GenerateDependenciesFromSyncToken(sync_token, host_);
   {
     base::AutoLock lock(lock_);
 
@@ -244,6 +252,27 @@ void SharedImageInterfaceProxy::DestroySharedImage(const SyncToken& sync_token,
   }
 }
 
+void SharedImageInterfaceProxy::DestroySharedImages(
+    const SyncToken& sync_token,
+    const std::vector<Mailbox>& mailboxes) {
+  if (mailboxes.empty())
+    return;
+  std::vector<SyncToken> dependencies =
+      GenerateDependenciesFromSyncToken(sync_token, host_);
+  {
+    base::AutoLock lock(lock_);
+
+    for (const auto& mailbox : mailboxes) {
+      DCHECK_NE(mailbox_to_usage_.count(mailbox), 0u);
+      mailbox_to_usage_.erase(mailbox);
+    }
+
+    last_flush_id_ = host_->EnqueueDeferredMessage(
+        GpuChannelMsg_DestroySharedImages(route_id_, mailboxes),
+        std::move(dependencies));
+  }
+}
+
 SyncToken SharedImageInterfaceProxy::GenVerifiedSyncToken() {
   SyncToken sync_token = GenUnverifiedSyncToken();
   // Force a synchronous IPC to validate sync token.
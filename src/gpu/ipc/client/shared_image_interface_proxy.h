@@ -39,6 +39,8 @@ class SharedImageInterfaceProxy {
                          const Mailbox& mailbox);
 
   void DestroySharedImage(const SyncToken& sync_token, const Mailbox& mailbox);
+  void DestroySharedImages(const SyncToken& sync_token,
+                           const std::vector<Mailbox>& mailboxes);
   SyncToken GenVerifiedSyncToken();
   SyncToken GenUnverifiedSyncToken();
   void Flush();
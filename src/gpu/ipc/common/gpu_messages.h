@@ -181,6 +181,8 @@ IPC_MESSAGE_ROUTED3(GpuChannelMsg_UpdateSharedImage,
                     uint32_t /* release_id */,
                     gfx::GpuFenceHandle /* in_fence_handle */)
 IPC_MESSAGE_ROUTED1(GpuChannelMsg_DestroySharedImage, gpu::Mailbox /* id */)
+IPC_MESSAGE_ROUTED1(GpuChannelMsg_DestroySharedImages,
+                    std::vector<gpu::Mailbox> /* ids */)
 #if defined(OS_WIN)
 IPC_MESSAGE_ROUTED1(GpuChannelMsg_CreateSwapChain,
                     GpuChannelMsg_CreateSwapChain_Params /* params */)
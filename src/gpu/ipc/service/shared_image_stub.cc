@@ -75,6 +75,8 @@ bool SharedImageStub::OnMessageReceived(const IPC::Message& msg) {
                         OnCreateGMBSharedImage)
     IPC_MESSAGE_HANDLER(GpuChannelMsg_UpdateSharedImage, OnUpdateSharedImage)
     IPC_MESSAGE_HANDLER(GpuChannelMsg_DestroySharedImage, OnDestroySharedImage)
+    IPC_MESSAGE_HANDLER(GpuChannelMsg_DestroySharedImages,
+                        OnDestroySharedImages)
     IPC_MESSAGE_HANDLER(GpuChannelMsg_RegisterSharedImageUploadBuffer,
                         OnRegisterSharedImageUploadBuffer)
 #if defined(OS_WIN)
@@ -296,6 +298,34 @@ void SharedImageStub::OnDestroySharedImage(const Mailbox& mailbox) {
   }
 }
 
+void SharedImageStub::OnDestroySharedImages(
+    const std::vector<Mailbox>& mailboxes) {
+  TRACE_EVENT1("gpu", "SharedImageStub::OnDestroySharedImages", "count",
+               mailboxes.size());
+  for (const auto& mailbox : mailboxes) {
+    if (!mailbox.IsSharedImage()) {
+      LOG(ERROR) << "SharedImageStub: Trying to destroy a SharedImage with a "
+                    "non-SharedImage mailbox.";
+      OnError();
+      return;
+    }
+  }
+
+  // Make the context current once for the whole batch.
+  if (!MakeContextCurrent()) {
+    OnError();
+    return;
+  }
+
+  for (const auto& mailbox : mailboxes) {
+    if (!factory_->DestroySharedImage(mailbox)) {
+      LOG(ERROR) << "SharedImageStub: Unable to destroy shared image";
+      OnError();
+      return;
+    }
+  }
+}
+
 #if defined(OS_WIN)
 void SharedImageStub::OnCreateSwapChain(
     const GpuChannelMsg_CreateSwapChain_Params& params) {
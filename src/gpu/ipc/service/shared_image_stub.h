@@ -80,6 +80,7 @@ class GPU_IPC_SERVICE_EXPORT SharedImageStub
                            uint32_t release_id,
                            const gfx::GpuFenceHandle& in_fence_handle);
   void OnDestroySharedImage(const Mailbox& mailbox);
+  void OnDestroySharedImages(const std::vector<Mailbox>& mailboxes);
   void OnRegisterSharedImageUploadBuffer(base::ReadOnlySharedMemoryRegion shm);
 #if defined(OS_WIN)
   void OnCreateSwapChain(const GpuChannelMsg_CreateSwapChain_Params& params);
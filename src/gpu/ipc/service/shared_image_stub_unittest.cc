@@ -0,0 +1,155 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/ipc/service/shared_image_stub.h"
+
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/test/test_simple_task_runner.h"
+#include "components/viz/common/resources/resource_format.h"
+#include "gpu/command_buffer/common/mailbox.h"
+#include "gpu/command_buffer/common/shared_image_usage.h"
+#include "gpu/command_buffer/common/sync_token.h"
+#include "gpu/command_buffer/service/scheduler.h"
+#include "gpu/command_buffer/service/shared_image_factory.h"
+#include "gpu/command_buffer/service/sync_point_manager.h"
+#include "gpu/ipc/common/command_buffer_id.h"
+#include "gpu/ipc/common/gpu_messages.h"
+#include "gpu/ipc/service/gpu_channel.h"
+#include "gpu/ipc/service/gpu_channel_manager.h"
+#include "gpu/ipc/service/gpu_channel_test_common.h"
+#include "ui/gfx/color_space.h"
+#include "ui/gfx/geometry/size.h"
+
+namespace gpu {
+
+class SharedImageStubTest : public GpuChannelTestCommon {
+ public:
+  SharedImageStubTest() : GpuChannelTestCommon(true /* use_stub_bindings */) {}
+  ~SharedImageStubTest() override = default;
+
+ protected:
+  static constexpr int32_t kClientId = 1;
+  static constexpr int32_t kRouteId =
+      static_cast<int32_t>(GpuChannelReservedRoutes::kSharedImageInterface);
+
+  GpuChannel* channel() const {
+    return channel_manager()->LookupChannel(kClientId);
+  }
+
+  // Shared image messages are only accepted as deferred messages, which is how
+  // SharedImageInterfaceProxy sends them.
+  void FlushDeferredMessage(const IPC::Message& msg,
+                            std::vector<SyncToken> sync_token_fences) {
+    GpuDeferredMessage deferred_message;
+    deferred_message.message = msg;
+    deferred_message.sync_token_fences = std::move(sync_token_fences);
+    std::vector<GpuDeferredMessage> deferred_messages;
+    deferred_messages.push_back(std::move(deferred_message));
+    HandleMessage(channel(), new GpuChannelMsg_FlushDeferredMessages(
+                                 std::move(deferred_messages)));
+    task_runner()->RunUntilIdle();
+  }
+
+  Mailbox CreateSharedImage() {
+    GpuChannelMsg_CreateSharedImage_Params params;
+    params.mailbox = Mailbox::GenerateForSharedImage();
+    params.format = viz::ResourceFormat::RGBA_8888;
+    params.size = gfx::Size(16, 16);
+    params.color_space = gfx::ColorSpace::CreateSRGB();
+    params.usage = SHARED_IMAGE_USAGE_GLES2;
+    params.release_id = ++release_id_;
+    FlushDeferredMessage(GpuChannelMsg_CreateSharedImage(kRouteId, params),
+                         std::vector<SyncToken>());
+    return params.mailbox;
+  }
+
+  void DestroySharedImages(std::vector<Mailbox> mailboxes,
+                           std::vector<SyncToken> sync_token_fences) {
+    FlushDeferredMessage(
+        GpuChannelMsg_DestroySharedImages(kRouteId, std::move(mailboxes)),
+        std::move(sync_token_fences));
+  }
+
+  bool HasImages() const {
+    return channel()->shared_image_stub()->factory()->HasImages();
+  }
+
+ private:
+  uint32_t release_id_ = 0;
+};
+
+TEST_F(SharedImageStubTest, DestroySharedImagesDestroysEveryMailbox) {
+  ASSERT_TRUE(CreateChannel(kClientId, false));
+  Mailbox kept = CreateSharedImage();
+  std::vector<Mailbox> batch = {CreateSharedImage(), CreateSharedImage()};
+  ASSERT_TRUE(channel());
+  ASSERT_TRUE(HasImages());
+
+  DestroySharedImages(batch, std::vector<SyncToken>());
+  ASSERT_TRUE(channel());
+  EXPECT_TRUE(HasImages());
+
+  // Only |kept| is left, so destroying it leaves no images behind.
+  DestroySharedImages({kept}, std::vector<SyncToken>());
+  ASSERT_TRUE(channel());
+  EXPECT_FALSE(HasImages());
+}
+
+TEST_F(SharedImageStubTest, DestroySharedImagesRejectsNonSharedImageMailbox) {
+  ASSERT_TRUE(CreateChannel(kClientId, false));
+  Mailbox mailbox = CreateSharedImage();
+  ASSERT_TRUE(channel());
+
+  // A mailbox that was not generated for a SharedImage is a client error,
+  // which tears down the channel.
+  DestroySharedImages({mailbox, Mailbox::Generate()},
+                      std::vector<SyncToken>());
+  EXPECT_FALSE(channel());
+}
+
+TEST_F(SharedImageStubTest, DestroySharedImagesWaitsForSyncToken) {
+  ASSERT_TRUE(CreateChannel(kClientId, false));
+  std::vector<Mailbox> batch = {CreateSharedImage(), CreateSharedImage()};
+  ASSERT_TRUE(channel());
+
+  // The fence is released by a sequence on another task runner, so that it
+  // can be held back while the GPU thread runs.
+  auto release_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  SequenceId release_sequence_id = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, release_task_runner);
+  CommandBufferNamespace namespace_id = CommandBufferNamespace::GPU_IO;
+  CommandBufferId command_buffer_id = CommandBufferId::FromUnsafeValue(42);
+  scoped_refptr<SyncPointClientState> release_state =
+      channel_manager()->sync_point_manager()->CreateSyncPointClientState(
+          namespace_id, command_buffer_id, release_sequence_id);
+
+  uint64_t release = 1;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      release_sequence_id,
+      base::BindOnce(&SyncPointClientState::ReleaseFenceSync, release_state,
+                     release),
+      std::vector<SyncToken>()));
+
+  SyncToken sync_token(namespace_id, command_buffer_id, release);
+  DestroySharedImages(batch, {sync_token});
+  ASSERT_TRUE(channel());
+  EXPECT_TRUE(HasImages());
+
+  // Releasing the fence lets the batch run on the GPU thread.
+  release_task_runner->RunUntilIdle();
+  task_runner()->RunUntilIdle();
+  ASSERT_TRUE(channel());
+  EXPECT_FALSE(HasImages());
+
+  release_state->Destroy();
+  scheduler()->DestroySequence(release_sequence_id);
+}
+
+}  // namespace gpu
@@ -0,0 +1,95 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "base/time/time.h"
+#include "gpu/config/gpu_control_list.h"
+#include "gpu/config/gpu_driver_bug_list.h"
+#include "gpu/config/gpu_info.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace gpu {
+namespace {
+
+constexpr int kWarmupRuns = 5;
+constexpr int kTestRuns = 200;
+
+struct PlatformConfig {
+  const char* story;
+  GpuControlList::OsType os_type;
+  const char* os_version;
+  uint32_t vendor_id;
+  uint32_t device_id;
+  const char* driver_vendor;
+  const char* driver_version;
+  const char* gl_vendor;
+  const char* gl_renderer;
+  const char* gl_version;
+};
+
+// A few common configurations, so that both the vendor/device filtering and
+// the version parsing of the driver bug list entries get exercised.
+const PlatformConfig kPlatformConfigs[] = {
+    {"linux_intel", GpuControlList::kOsLinux, "5.4.0", 0x8086, 0x5916, "Mesa",
+     "19.2.8", "Intel Open Source Technology Center",
+     "Mesa DRI Intel(R) HD Graphics 620 (KBL GT2)", "4.6 (Core Profile) Mesa"},
+    {"win_nvidia", GpuControlList::kOsWin, "10.0.18363", 0x10de, 0x1c82, "",
+     "26.21.14.4250", "Google Inc.",
+     "ANGLE (NVIDIA GeForce GTX 1050 Ti Direct3D11 vs_5_0 ps_5_0)",
+     "OpenGL ES 2.0 (ANGLE 2.1.0)"},
+    {"android_adreno", GpuControlList::kOsAndroid, "10", 0, 0, "", "",
+     "Qualcomm", "Adreno (TM) 630", "OpenGL ES 3.2 V@415.0"},
+};
+
+GPUInfo MakeGPUInfo(const PlatformConfig& config) {
+  GPUInfo gpu_info;
+  gpu_info.gpu.vendor_id = config.vendor_id;
+  gpu_info.gpu.device_id = config.device_id;
+  gpu_info.gpu.active = true;
+  gpu_info.gpu.driver_vendor = config.driver_vendor;
+  gpu_info.gpu.driver_version = config.driver_version;
+  gpu_info.gl_vendor = config.gl_vendor;
+  gpu_info.gl_renderer = config.gl_renderer;
+  gpu_info.gl_version = config.gl_version;
+  return gpu_info;
+}
+
+// Measures the GPU process startup cost of creating the driver bug list and
+// matching it against the GPU info.
+TEST(GpuDriverBugListPerfTest, MakeDecision) {
+  for (const PlatformConfig& config : kPlatformConfigs) {
+    GPUInfo gpu_info = MakeGPUInfo(config);
+    base::TimeDelta total_create_time;
+    base::TimeDelta total_decision_time;
+    size_t workaround_count = 0;
+    for (int i = 0; i < kWarmupRuns + kTestRuns; ++i) {
+      base::TimeTicks start = base::TimeTicks::Now();
+      std::unique_ptr<GpuDriverBugList> list = GpuDriverBugList::Create();
+      base::TimeTicks created = base::TimeTicks::Now();
+      std::set<int32_t> workarounds =
+          list->MakeDecision(config.os_type, config.os_version, gpu_info);
+      base::TimeTicks decided = base::TimeTicks::Now();
+      workaround_count = workarounds.size();
+      if (i < kWarmupRuns)
+        continue;
+      total_create_time += created - start;
+      total_decision_time += decided - created;
+    }
+
+    perf_test::PerfResultReporter reporter("GpuDriverBugList.", config.story);
+    reporter.RegisterImportantMetric("create_time", "us");
+    reporter.RegisterImportantMetric("make_decision_time", "us");
+    reporter.RegisterFyiMetric("workarounds", "count");
+    reporter.AddResult("create_time", total_create_time / kTestRuns);
+    reporter.AddResult("make_decision_time", total_decision_time / kTestRuns);
+    reporter.AddResult("workarounds", workaround_count);
+  }
+}
+
+}  // namespace
+}  // namespace gpu
@@ -0,0 +1,136 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/single_thread_task_runner.h"
+#include "base/threading/thread.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "gpu/command_buffer/service/scheduler.h"
+#include "gpu/command_buffer/service/sync_point_manager.h"
+#include "gpu/config/gpu_preferences.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace gpu {
+namespace {
+
+// Time each task of the busy sequence keeps the GPU thread occupied, standing
+// in for a heavy WebGL command buffer flush.
+constexpr base::TimeDelta kBusyTaskTime = base::TimeDelta::FromMilliseconds(4);
+constexpr int kWarmupRuns = 5;
+constexpr int kTestRuns = 100;
+
+// Measures how long a high priority sequence waits to run while a low priority
+// sequence keeps the GPU thread busy, with the high priority sequence either
+// sharing the GPU thread or running on a thread of its own.
+class SchedulerPerfTest : public testing::Test {
+ public:
+  SchedulerPerfTest()
+      : scheduler_(base::ThreadTaskRunnerHandle::Get(),
+                   &sync_point_manager_,
+                   GpuPreferences()),
+        other_thread_("SchedulerPerfTestThread") {
+    CHECK(other_thread_.Start());
+  }
+
+  ~SchedulerPerfTest() override { other_thread_.Stop(); }
+
+ protected:
+  void RunTest(const std::string& story, bool use_other_thread) {
+    busy_sequence_id_ = scheduler_.CreateSequence(SchedulingPriority::kLow);
+    SequenceId sequence_id =
+        use_other_thread
+            ? scheduler_.CreateSequence(SchedulingPriority::kHigh,
+                                        other_thread_.task_runner())
+            : scheduler_.CreateSequence(SchedulingPriority::kHigh);
+
+    stop_busy_ = false;
+    ScheduleBusyTask();
+
+    base::TimeDelta total_latency;
+    base::TimeDelta max_latency;
+    for (int i = 0; i < kWarmupRuns + kTestRuns; ++i) {
+      base::TimeDelta latency = MeasureLatency(sequence_id);
+      if (i < kWarmupRuns)
+        continue;
+      total_latency += latency;
+      max_latency = std::max(max_latency, latency);
+    }
+
+    stop_busy_ = true;
+    base::RunLoop().RunUntilIdle();
+    scheduler_.DestroySequence(sequence_id);
+    scheduler_.DestroySequence(busy_sequence_id_);
+
+    perf_test::PerfResultReporter reporter("Scheduler.", story);
+    reporter.RegisterImportantMetric("mean_latency", "us");
+    reporter.RegisterImportantMetric("max_latency", "us");
+    reporter.AddResult("mean_latency", total_latency / kTestRuns);
+    reporter.AddResult("max_latency", max_latency);
+  }
+
+ private:
+  void ScheduleBusyTask() {
+    scheduler_.ScheduleTask(Scheduler::Task(
+        busy_sequence_id_,
+        base::BindOnce(&SchedulerPerfTest::RunBusyTask, base::Unretained(this)),
+        std::vector<SyncToken>()));
+  }
+
+  void RunBusyTask() {
+    base::TimeTicks end = base::TimeTicks::Now() + kBusyTaskTime;
+    while (base::TimeTicks::Now() < end) {
+    }
+    if (!stop_busy_)
+      ScheduleBusyTask();
+  }
+
+  base::TimeDelta MeasureLatency(SequenceId sequence_id) {
+    base::RunLoop run_loop;
+    scoped_refptr<base::SingleThreadTaskRunner> main_task_runner =
+        base::ThreadTaskRunnerHandle::Get();
+    base::TimeDelta latency;
+    base::TimeTicks scheduled_time = base::TimeTicks::Now();
+    scheduler_.ScheduleTask(Scheduler::Task(
+        sequence_id, base::BindOnce(
+                         [](base::TimeTicks scheduled_time,
+                            base::TimeDelta* latency,
+                            scoped_refptr<base::SingleThreadTaskRunner>
+                                main_task_runner,
+                            base::OnceClosure quit_closure) {
+                           *latency = base::TimeTicks::Now() - scheduled_time;
+                           main_task_runner->PostTask(FROM_HERE,
+                                                      std::move(quit_closure));
+                         },
+                         scheduled_time, &latency, main_task_runner,
+                         run_loop.QuitClosure()),
+        std::vector<SyncToken>()));
+    run_loop.Run();
+    return latency;
+  }
+
+  SyncPointManager sync_point_manager_;
+  Scheduler scheduler_;
+  base::Thread other_thread_;
+  SequenceId busy_sequence_id_;
+  bool stop_busy_ = false;
+};
+
+TEST_F(SchedulerPerfTest, HighPrioritySequenceOnSameThread) {
+  RunTest("same_thread", false);
+}
+
+TEST_F(SchedulerPerfTest, HighPrioritySequenceOnOtherThread) {
+  RunTest("other_thread", true);
+}
+
+}  // namespace
+}  // namespace gpu
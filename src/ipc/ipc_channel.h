@@ -82,7 +82,13 @@ class COMPONENT_EXPORT(IPC) Channel : public Sender {
     // The client will return the message with hops = 1, *after* it
     // has received the message that contains the FD. When we
     // receive it again on the sender side, we close the FD.
-    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1
+    CLOSE_FD_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 1,
+    // The SHARED_MEMORY_MESSAGE_TYPE wraps a large message that ChannelMojo's
+    // MessagePipeReader sends through a read-only shared memory region
+    // instead of inline. The message has a special routing_id
+    // (MSG_ROUTING_NONE) and is unwrapped by the receiving MessagePipeReader
+    // before dispatch.
+    SHARED_MEMORY_MESSAGE_TYPE = HELLO_MESSAGE_TYPE - 2
   };
 
   // Helper interface a Channel may implement to expose support for associated
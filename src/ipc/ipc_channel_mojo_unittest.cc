@@ -506,6 +506,165 @@ DEFINE_IPC_CHANNEL_MOJO_TEST_CLIENT(IPCChannelMojoTestSendMessagePipeClient) {
   Close();
 }
 
+// Large enough for the message to be sent through shared memory.
+constexpr size_t kLargeMessagePayloadSize = 1024 * 1024;
+
+class ListenerThatExpectsLargeMessageAndPipe : public TestListenerBase {
+ public:
+  explicit ListenerThatExpectsLargeMessageAndPipe(
+      base::OnceClosure quit_closure)
+      : TestListenerBase(std::move(quit_closure)) {}
+
+  ~ListenerThatExpectsLargeMessageAndPipe() override = default;
+
+  bool OnMessageReceived(const IPC::Message& message) override {
+    base::PickleIterator iter(message);
+    HandleSendingHelper::ReadReceivedPipe(message, &iter);
+    std::string payload;
+    EXPECT_TRUE(iter.ReadString(&payload));
+    EXPECT_EQ(std::string(kLargeMessagePayloadSize, 'x'), payload);
+    ListenerThatExpectsOK::SendOK(sender());
+    return true;
+  }
+};
+
+TEST_F(IPCChannelMojoTest, SendLargeMessageWithMessagePipe) {
+  Init("IPCChannelMojoTestSendLargeMessageWithMessagePipeClient");
+
+  base::RunLoop run_loop;
+  ListenerThatExpectsOK listener(run_loop.QuitClosure());
+  CreateChannel(&listener);
+  ASSERT_TRUE(ConnectChannel());
+
+  TestingMessagePipe pipe;
+  IPC::Message* message =
+      new IPC::Message(0, 2, IPC::Message::PRIORITY_NORMAL);
+  HandleSendingHelper::WritePipe(message, &pipe);
+  message->WriteString(std::string(kLargeMessagePayloadSize, 'x'));
+  ASSERT_TRUE(channel()->Send(message));
+
+  run_loop.Run();
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+
+DEFINE_IPC_CHANNEL_MOJO_TEST_CLIENT(
+    IPCChannelMojoTestSendLargeMessageWithMessagePipeClient) {
+  base::RunLoop run_loop;
+  ListenerThatExpectsLargeMessageAndPipe listener(run_loop.QuitClosure());
+  Connect(&listener);
+  listener.set_sender(channel());
+
+  run_loop.Run();
+
+  Close();
+}
+
+// Returns a read-only region holding a copy of |size| bytes at |data|.
+base::ReadOnlySharedMemoryRegion CreateRegionWithContents(const void* data,
+                                                          size_t size) {
+  base::MappedReadOnlyRegion shm =
+      base::ReadOnlySharedMemoryRegion::Create(size);
+  CHECK(shm.IsValid());
+  memcpy(shm.mapping.memory(), data, size);
+  return std::move(shm.region);
+}
+
+// Sends a hand-built shared memory wrapper, laid out the way ChannelMojo lays
+// out the wrapper of a large message, but claiming |num_attachments|.
+void SendSharedMemoryWrapper(IPC::Sender* sender,
+                             base::ReadOnlySharedMemoryRegion region,
+                             uint32_t num_attachments) {
+  IPC::Message* wrapper = new IPC::Message(
+      MSG_ROUTING_NONE, IPC::Channel::SHARED_MEMORY_MESSAGE_TYPE,
+      IPC::Message::PRIORITY_NORMAL);
+  IPC::WriteParam(wrapper, std::move(region));
+  wrapper->WriteUInt32(num_attachments);
+  ASSERT_TRUE(sender->Send(wrapper));
+}
+
+constexpr int kMalformedWrapperCount = 4;
+
+TEST_F(IPCChannelMojoTest, MalformedSharedMemoryMessage) {
+  Init("IPCChannelMojoTestMalformedSharedMemoryMessageClient");
+
+  base::RunLoop run_loop;
+  ListenerThatExpectsOK listener(run_loop.QuitClosure());
+  CreateChannel(&listener);
+  ASSERT_TRUE(ConnectChannel());
+
+  IPC::Message inner(0, 2, IPC::Message::PRIORITY_NORMAL);
+  inner.WriteString("hello");
+
+  // A wrapper nested in a wrapper.
+  IPC::Message nested(MSG_ROUTING_NONE,
+                      IPC::Channel::SHARED_MEMORY_MESSAGE_TYPE,
+                      IPC::Message::PRIORITY_NORMAL);
+  nested.WriteUInt32(0);
+  SendSharedMemoryWrapper(
+      channel(), CreateRegionWithContents(nested.data(), nested.size()), 0);
+
+  // More attachments than the wrapper carries besides its region.
+  SendSharedMemoryWrapper(
+      channel(), CreateRegionWithContents(inner.data(), inner.size()), 1);
+
+  // No region at all.
+  SendSharedMemoryWrapper(channel(), base::ReadOnlySharedMemoryRegion(), 0);
+
+  // A region holding only part of the message.
+  SendSharedMemoryWrapper(
+      channel(), CreateRegionWithContents(inner.data(), inner.size() - 1), 0);
+
+  // Each malformed wrapper is reported, and the channel stays usable.
+  SendString(channel(), "hello");
+
+  run_loop.Run();
+  channel()->Close();
+
+  EXPECT_TRUE(WaitForClientShutdown());
+  DestroyChannel();
+}
+
+class ListenerThatCountsBadMessages : public TestListenerBase {
+ public:
+  explicit ListenerThatCountsBadMessages(base::OnceClosure quit_closure)
+      : TestListenerBase(std::move(quit_closure)) {}
+
+  ~ListenerThatCountsBadMessages() override = default;
+
+  bool OnMessageReceived(const IPC::Message& message) override {
+    base::PickleIterator iter(message);
+    std::string should_be_hello;
+    EXPECT_TRUE(iter.ReadString(&should_be_hello));
+    EXPECT_EQ("hello", should_be_hello);
+    EXPECT_EQ(kMalformedWrapperCount, bad_messages_);
+    ListenerThatExpectsOK::SendOK(sender());
+    RunQuitClosure();
+    return true;
+  }
+
+  void OnBadMessageReceived(const IPC::Message& message) override {
+    ++bad_messages_;
+  }
+
+ private:
+  int bad_messages_ = 0;
+};
+
+DEFINE_IPC_CHANNEL_MOJO_TEST_CLIENT(
+    IPCChannelMojoTestMalformedSharedMemoryMessageClient) {
+  base::RunLoop run_loop;
+  ListenerThatCountsBadMessages listener(run_loop.QuitClosure());
+  Connect(&listener);
+  listener.set_sender(channel());
+
+  run_loop.Run();
+
+  Close();
+}
+
 void ReadOK(mojo::MessagePipeHandle pipe) {
   std::vector<uint8_t> should_be_ok;
   CHECK_EQ(MOJO_RESULT_OK, mojo::Wait(pipe, MOJO_HANDLE_SIGNAL_READABLE));
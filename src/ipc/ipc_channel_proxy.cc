@@ -27,8 +27,27 @@
 
 namespace IPC {
 
+namespace {
+
+// Upper bound on the number of messages dispatched by a single listener task,
+// so that other tasks on the listener thread aren't held back for too long.
+constexpr size_t kMaxMessagesPerBatch = 16;
+
+}  // namespace
+
 //------------------------------------------------------------------------------
 
+ChannelProxy::Context::MessageBatch::MessageBatch(uint64_t id) : id(id) {}
+
+ChannelProxy::Context::MessageBatch::MessageBatch(MessageBatch&& other) =
+    default;
+
+ChannelProxy::Context::MessageBatch::~MessageBatch() = default;
+
+ChannelProxy::Context::PendingMessages::PendingMessages() = default;
+
+ChannelProxy::Context::PendingMessages::~PendingMessages() = default;
+
 ChannelProxy::Context::Context(
     Listener* listener,
     const scoped_refptr<base::SingleThreadTaskRunner>& ipc_task_runner,
@@ -87,9 +106,12 @@ bool ChannelProxy::Context::TryFilters(const Message& message) {
 
   if (message_filter_router_->TryFilters(message)) {
     if (message.dispatch_error()) {
-      GetTaskRunner(message.routing_id())
-          ->PostTask(FROM_HERE, base::BindOnce(&Context::OnDispatchBadMessage,
-                                               this, message));
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+          GetTaskRunner(message.routing_id());
+      CloseMessageBatch(task_runner);
+      task_runner->PostTask(
+          FROM_HERE,
+          base::BindOnce(&Context::OnDispatchBadMessage, this, message));
     }
 #if BUILDFLAG(IPC_MESSAGE_LOG_ENABLED)
     if (logger->Enabled())
@@ -128,12 +150,50 @@ bool ChannelProxy::Context::OnMessageReceived(const Message& message) {
 
 // Called on the IPC::Channel thread
 bool ChannelProxy::Context::OnMessageReceivedNoFilter(const Message& message) {
-  GetTaskRunner(message.routing_id())
-      ->PostTask(FROM_HERE,
-                 base::BindOnce(&Context::OnDispatchMessage, this, message));
+  scoped_refptr<base::SingleThreadTaskRunner> task_runner =
+      GetTaskRunner(message.routing_id());
+  uint64_t batch_id;
+  {
+    base::AutoLock lock(pending_messages_lock_);
+    PendingMessages& pending = pending_messages_[task_runner];
+    if (pending.last_batch_open &&
+        pending.batches.back().messages.size() < kMaxMessagesPerBatch) {
+      // A task to dispatch this batch has already been posted.
+      auto& messages = pending.batches.back().messages;
+      if (!message.is_sync() &&
+          coalesced_message_types_.contains(message.type())) {
+        for (auto it = messages.begin(); it != messages.end(); ++it) {
+          if ((*it)->type() == message.type() &&
+              (*it)->routing_id() == message.routing_id()) {
+            messages.erase(it);
+            break;
+          }
+        }
+      }
+      messages.push_back(std::make_unique<Message>(message));
+      return true;
+    }
+    batch_id = next_batch_id_++;
+    pending.batches.emplace_back(batch_id);
+    pending.batches.back().messages.push_back(
+        std::make_unique<Message>(message));
+    pending.last_batch_open = true;
+  }
+  task_runner->PostTask(FROM_HERE,
+                        base::BindOnce(&Context::OnDispatchMessages, this,
+                                       task_runner, batch_id));
   return true;
 }
 
+// Called on the IPC::Channel thread
+void ChannelProxy::Context::CloseMessageBatch(
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner) {
+  base::AutoLock lock(pending_messages_lock_);
+  auto it = pending_messages_.find(task_runner);
+  if (it != pending_messages_.end())
+    it->second.last_batch_open = false;
+}
+
 // Called on the IPC::Channel thread
 void ChannelProxy::Context::OnChannelConnected(int32_t peer_pid) {
   // We cache off the peer_pid so it can be safely accessed from both threads.
@@ -149,6 +209,7 @@ void ChannelProxy::Context::OnChannelConnected(int32_t peer_pid) {
   OnAddFilter();
 
   // See above comment about using default_listener_task_runner_ here.
+  CloseMessageBatch(default_listener_task_runner_);
   default_listener_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&Context::OnDispatchConnected, this));
 }
@@ -159,6 +220,7 @@ void ChannelProxy::Context::OnChannelError() {
     filters_[i]->OnChannelError();
 
   // See above comment about using default_listener_task_runner_ here.
+  CloseMessageBatch(default_listener_task_runner_);
   default_listener_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&Context::OnDispatchError, this));
 }
@@ -167,6 +229,7 @@ void ChannelProxy::Context::OnChannelError() {
 void ChannelProxy::Context::OnAssociatedInterfaceRequest(
     const std::string& interface_name,
     mojo::ScopedInterfaceEndpointHandle handle) {
+  CloseMessageBatch(default_listener_task_runner_);
   default_listener_task_runner_->PostTask(
       FROM_HERE, base::BindOnce(&Context::OnDispatchAssociatedInterfaceRequest,
                                 this, interface_name, std::move(handle)));
@@ -334,6 +397,66 @@ void ChannelProxy::Context::OnDispatchMessage(const Message& message) {
 #endif
 }
 
+// Called on the listener's thread
+void ChannelProxy::Context::OnDispatchMessages(
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    uint64_t batch_id) {
+  // Dispatch one message at a time rather than taking the whole batch, so that
+  // if a message handler runs a nested loop, a queued task dispatches the rest
+  // of this batch first and messages stay in order.
+  {
+    base::AutoLock lock(pending_messages_lock_);
+    auto it = pending_messages_.find(task_runner);
+    if (it != pending_messages_.end())
+      it->second.follow_up_posted = false;
+  }
+  while (true) {
+    std::unique_ptr<Message> message;
+    bool post_follow_up = false;
+    {
+      base::AutoLock lock(pending_messages_lock_);
+      auto it = pending_messages_.find(task_runner);
+      if (it == pending_messages_.end())
+        return;
+      auto& batches = it->second.batches;
+      DCHECK(!batches.empty());
+      if (batches.front().id > batch_id)
+        return;
+      // Messages that arrive once dispatch has started go to a new batch, so
+      // that a batch can't keep growing while it is being drained.
+      if (batches.back().id <= batch_id)
+        it->second.last_batch_open = false;
+      message = std::move(batches.front().messages.front());
+      batches.front().messages.pop_front();
+      if (batches.front().messages.empty())
+        batches.pop_front();
+      if (batches.empty()) {
+        pending_messages_.erase(it);
+      } else if (batches.front().id <= batch_id &&
+                 !it->second.follow_up_posted) {
+        // The remaining messages have no task of their own. Queue one, so that
+        // a nested loop run by the handler below still dispatches them. When
+        // there is no nested loop, this loop drains them first and the task
+        // finds nothing to do.
+        it->second.follow_up_posted = true;
+        post_follow_up = true;
+      }
+    }
+    if (post_follow_up) {
+      task_runner->PostTask(FROM_HERE,
+                            base::BindOnce(&Context::OnDispatchMessages, this,
+                                           task_runner, batch_id));
+    }
+    OnDispatchMessage(*message);
+  }
+}
+
+// Called on the listener's thread
+void ChannelProxy::Context::AddCoalescedMessageType(uint32_t type) {
+  base::AutoLock lock(pending_messages_lock_);
+  coalesced_message_types_.insert(type);
+}
+
 // Called on the listener's thread.
 void ChannelProxy::Context::AddListenerTaskRunner(
     int32_t routing_id,
@@ -597,6 +720,11 @@ void ChannelProxy::RemoveFilter(MessageFilter* filter) {
                                 base::RetainedRef(filter)));
 }
 
+void ChannelProxy::AddCoalescedMessageType(uint32_t type) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  context_->AddCoalescedMessageType(type);
+}
+
 void ChannelProxy::AddGenericAssociatedInterfaceForIOThread(
     const std::string& name,
     const GenericAssociatedInterfaceFactory& factory) {
@@ -15,6 +15,8 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/component_export.h"
+#include "base/containers/circular_deque.h"
+#include "base/containers/flat_set.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequence_checker.h"
 #include "base/synchronization/lock.h"
@@ -169,6 +171,16 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
   void AddFilter(MessageFilter* filter);
   void RemoveFilter(MessageFilter* filter);
 
+  // Incoming messages are handed to the listener thread in batches. Once a
+  // message of |type| is queued for the listener, a later one with the same
+  // routing ID that arrives before the batch is dispatched replaces it. Only
+  // use this for messages whose latest instance supersedes earlier ones, such
+  // as state updates. Sync messages are never dropped.
+  //
+  // The replacement is dispatched in the position of the newer message, so it
+  // moves after any other messages received between the two.
+  void AddCoalescedMessageType(uint32_t type);
+
   using GenericAssociatedInterfaceFactory =
       base::RepeatingCallback<void(mojo::ScopedInterfaceEndpointHandle)>;
 
@@ -281,6 +293,9 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     // Dispatches a message on the listener thread.
     void OnDispatchMessage(const Message& message);
 
+    // Called on the listener thread.
+    void AddCoalescedMessageType(uint32_t type);
+
     // Sends |message| from appropriate thread.
     void Send(Message* message);
 
@@ -350,6 +365,18 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
         const std::string& interface_name,
         mojo::ScopedInterfaceEndpointHandle handle);
 
+    // Dispatches the messages queued for |task_runner| in batches up to and
+    // including |batch_id|.
+    void OnDispatchMessages(
+        scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+        uint64_t batch_id);
+
+    // Called on the IPC thread before posting any task other than
+    // OnDispatchMessages() to |task_runner|, so that messages received after
+    // that task stay ordered after it.
+    void CloseMessageBatch(
+        const scoped_refptr<base::SingleThreadTaskRunner>& task_runner);
+
     void ClearChannel();
 
     mojom::Channel& thread_safe_channel() {
@@ -413,6 +440,34 @@ class COMPONENT_EXPORT(IPC) ChannelProxy : public Sender {
     base::Lock pending_io_thread_interfaces_lock_;
     std::vector<std::pair<std::string, GenericAssociatedInterfaceFactory>>
         pending_io_thread_interfaces_;
+
+    // Messages received on the IPC thread which haven't been dispatched yet.
+    // Each batch is dispatched by one OnDispatchMessages() task.
+    struct MessageBatch {
+      explicit MessageBatch(uint64_t id);
+      MessageBatch(MessageBatch&& other);
+      ~MessageBatch();
+
+      uint64_t id;
+      base::circular_deque<std::unique_ptr<Message>> messages;
+    };
+    struct PendingMessages {
+      PendingMessages();
+      ~PendingMessages();
+
+      base::circular_deque<MessageBatch> batches;
+      // Whether messages may still be added to the last batch.
+      bool last_batch_open = false;
+      // Whether OnDispatchMessages() has queued a task for the rest of the
+      // batch it is draining, in case a message handler runs a nested loop.
+      bool follow_up_posted = false;
+    };
+    base::Lock pending_messages_lock_;
+    std::map<scoped_refptr<base::SingleThreadTaskRunner>, PendingMessages>
+        pending_messages_ GUARDED_BY(pending_messages_lock_);
+    uint64_t next_batch_id_ GUARDED_BY(pending_messages_lock_) = 0;
+    base::flat_set<uint32_t> coalesced_message_types_
+        GUARDED_BY(pending_messages_lock_);
   };
 
   Context* context() { return context_.get(); }
@@ -8,10 +8,15 @@
 #include <stdint.h>
 #include <memory>
 
+#include "base/bind.h"
+#include "base/callback.h"
 #include "base/message_loop/message_pump_type.h"
 #include "base/pickle.h"
 #include "base/run_loop.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/test/bind_test_util.h"
 #include "base/threading/thread.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "ipc/ipc_message.h"
 #include "ipc/ipc_test_base.h"
 #include "ipc/message_filter.h"
@@ -59,6 +64,7 @@ class QuitListener : public IPC::Listener {
   bool OnMessageReceived(const IPC::Message& message) override {
     IPC_BEGIN_MESSAGE_MAP(QuitListener, message)
       IPC_MESSAGE_HANDLER(WorkerMsg_Quit, OnQuit)
+      IPC_MESSAGE_HANDLER(WorkerMsg_Bounce, OnBounce)
       IPC_MESSAGE_HANDLER(TestMsg_BadMessage, OnBadMessage)
     IPC_END_MESSAGE_MAP()
     return true;
@@ -68,6 +74,12 @@ class QuitListener : public IPC::Listener {
     bad_message_received_ = true;
   }
 
+  void OnBounce() {
+    bounce_count_++;
+    if (bounce_callback_)
+      bounce_callback_.Run();
+  }
+
   void OnChannelError() override { CHECK(quit_message_received_); }
 
   void OnQuit() {
@@ -82,6 +94,8 @@ class QuitListener : public IPC::Listener {
 
   bool bad_message_received_ = false;
   bool quit_message_received_ = false;
+  int bounce_count_ = 0;
+  base::RepeatingClosure bounce_callback_;
   base::RunLoop* run_loop_ = nullptr;
 };
 
@@ -233,6 +247,29 @@ class MessageCountFilter : public IPC::MessageFilter {
   bool message_filtering_enabled_ = false;
 };
 
+// Signals an event when a message of a given type reaches the IPC thread.
+class MessageWaitFilter : public IPC::MessageFilter {
+ public:
+  explicit MessageWaitFilter(uint32_t message_type)
+      : message_type_(message_type),
+        event_(base::WaitableEvent::ResetPolicy::MANUAL,
+               base::WaitableEvent::InitialState::NOT_SIGNALED) {}
+
+  bool OnMessageReceived(const IPC::Message& message) override {
+    if (message.type() == message_type_)
+      event_.Signal();
+    return false;
+  }
+
+  void Wait() { event_.Wait(); }
+
+ private:
+  ~MessageWaitFilter() override = default;
+
+  const uint32_t message_type_;
+  base::WaitableEvent event_;
+};
+
 class IPCChannelProxyTest : public IPCChannelMojoTestBase {
  public:
   IPCChannelProxyTest() = default;
@@ -271,6 +308,27 @@ class IPCChannelProxyTest : public IPCChannelMojoTestBase {
     return listener_->bad_message_received_;
   }
 
+  int ListenerBounceCount() { return listener_->bounce_count_; }
+
+  // Runs |callback| on the listener thread after each bounce message.
+  void SetBounceCallback(base::RepeatingClosure callback) {
+    listener_->bounce_callback_ = std::move(callback);
+  }
+
+  // Sends |count| bounce messages followed by a quit message, and holds the
+  // listener thread until all replies have been queued for it, so that they
+  // are dispatched as a single batch.
+  void SendBouncesAndWaitForBatch(int count) {
+    auto filter = base::MakeRefCounted<MessageWaitFilter>(WorkerMsg_Quit::ID);
+    channel_proxy()->AddFilter(filter.get());
+    for (int i = 0; i < count; ++i)
+      sender()->Send(new WorkerMsg_Bounce);
+    sender()->Send(new WorkerMsg_Quit);
+    filter->Wait();
+    CreateRunLoopAndRun(&listener_->run_loop_);
+    EXPECT_TRUE(WaitForClientShutdown());
+  }
+
   IPC::ChannelProxy* channel_proxy() { return channel_proxy_.get(); }
   IPC::Sender* sender() { return channel_proxy_.get(); }
 
@@ -383,6 +441,65 @@ TEST_F(IPCChannelProxyTest, BadMessageOnIPCThread) {
   EXPECT_TRUE(DidListenerGetBadMessage());
 }
 
+TEST_F(IPCChannelProxyTest, BatchedMessages) {
+  SendBouncesAndWaitForBatch(5);
+  EXPECT_EQ(5, ListenerBounceCount());
+}
+
+TEST_F(IPCChannelProxyTest, CoalescedMessages) {
+  channel_proxy()->AddCoalescedMessageType(WorkerMsg_Bounce::ID);
+  SendBouncesAndWaitForBatch(5);
+  EXPECT_EQ(1, ListenerBounceCount());
+}
+
+// A handler running a nested loop still sees the later messages of its batch,
+// even though they share the batch's single dispatch task.
+TEST_F(IPCChannelProxyTest, NestedLoopSeesRestOfBatch) {
+  base::RunLoop* nested_loop = nullptr;
+  SetBounceCallback(base::BindLambdaForTesting([&]() {
+    if (ListenerBounceCount() == 1) {
+      base::RunLoop loop(base::RunLoop::Type::kNestableTasksAllowed);
+      nested_loop = &loop;
+      loop.Run();
+      nested_loop = nullptr;
+    } else if (nested_loop) {
+      nested_loop->Quit();
+    }
+  }));
+
+  SendBouncesAndWaitForBatch(2);
+  EXPECT_EQ(2, ListenerBounceCount());
+}
+
+// Messages which arrive while a batch is being dispatched don't join it, so a
+// task posted to the listener thread meanwhile isn't held back by the whole
+// burst.
+TEST_F(IPCChannelProxyTest, TaskInterleavedWithLongBurst) {
+  constexpr int kBurstSize = 100;
+  auto filter = base::MakeRefCounted<MessageWaitFilter>(WorkerMsg_Quit::ID);
+  channel_proxy()->AddFilter(filter.get());
+
+  int bounces_before_task = 0;
+  SetBounceCallback(base::BindLambdaForTesting([&]() {
+    if (ListenerBounceCount() != 1)
+      return;
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindLambdaForTesting(
+                       [&]() { bounces_before_task = ListenerBounceCount(); }));
+    // Let the rest of the burst reach the IPC thread while the first batch is
+    // still being dispatched.
+    filter->Wait();
+  }));
+
+  for (int i = 0; i < kBurstSize; ++i)
+    sender()->Send(new WorkerMsg_Bounce);
+  SendQuitMessageAndWaitForIdle();
+
+  EXPECT_EQ(kBurstSize, ListenerBounceCount());
+  EXPECT_GT(bounces_before_task, 0);
+  EXPECT_LT(bounces_before_task, kBurstSize);
+}
+
 class IPCChannelBadMessageTest : public IPCChannelMojoTestBase {
  public:
   void SetUp() override {
@@ -48,6 +48,18 @@ std::vector<TestParams> GetDefaultTestParams() {
   std::vector<TestParams> list;
   list.push_back({144, 20, 10, 10});
   list.push_back({144, 60, 10, 10});
+  // Bursts of small messages, like input events, which the listener side of
+  // ChannelProxy dispatches in batches.
+  list.push_back({144, 60, 100, 10});
+  return list;
+}
+
+// Sizes at which legacy IPC messages are sent through shared memory.
+std::vector<TestParams> GetLargeMessageTestParams() {
+  std::vector<TestParams> list;
+  list.push_back({64 * 1024, 60, 1, 10});
+  list.push_back({1024 * 1024, 60, 1, 10});
+  list.push_back({16 * 1024 * 1024, 10, 1, 10});
   return list;
 }
 
@@ -212,7 +224,9 @@ class ChannelSteadyPingPongTest : public IPCChannelMojoTestBase {
   ChannelSteadyPingPongTest() = default;
   ~ChannelSteadyPingPongTest() override = default;
 
-  void RunPingPongServer(const std::string& label, bool sync) {
+  void RunPingPongServer(const std::string& label,
+                         bool sync,
+                         const std::vector<TestParams>& params_list) {
     Init("MojoPerfTestClient");
 
     // Set up IPC channel and start client.
@@ -237,7 +251,6 @@ class ChannelSteadyPingPongTest : public IPCChannelMojoTestBase {
     listener.Init(channel_proxy.get());
 
     LockThreadAffinity thread_locker(kSharedCore);
-    std::vector<TestParams> params_list = GetDefaultTestParams();
     for (const auto& params : params_list) {
       base::RunLoop run_loop;
 
@@ -259,11 +272,15 @@ class ChannelSteadyPingPongTest : public IPCChannelMojoTestBase {
 };
 
 TEST_F(ChannelSteadyPingPongTest, AsyncPingPong) {
-  RunPingPongServer("IPC_CPU_Async", false);
+  RunPingPongServer("IPC_CPU_Async", false, GetDefaultTestParams());
 }
 
 TEST_F(ChannelSteadyPingPongTest, SyncPingPong) {
-  RunPingPongServer("IPC_CPU_Sync", true);
+  RunPingPongServer("IPC_CPU_Sync", true, GetDefaultTestParams());
+}
+
+TEST_F(ChannelSteadyPingPongTest, AsyncLargeMessagePingPong) {
+  RunPingPongServer("IPC_CPU_Async_Large", false, GetLargeMessageTestParams());
 }
 
 class MojoSteadyPingPongTest : public mojo::core::test::MojoTestBase {
@@ -5,6 +5,7 @@
 #include "ipc/ipc_message_pipe_reader.h"
 
 #include <stdint.h>
+#include <string.h>
 
 #include <utility>
 
@@ -13,14 +14,124 @@
 #include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/read_only_shared_memory_region.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/numerics/safe_conversions.h"
 #include "base/single_thread_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "build/build_config.h"
 #include "ipc/ipc_channel_mojo.h"
+#include "ipc/ipc_message_attachment_set.h"
+#include "ipc/ipc_message_utils.h"
 #include "mojo/public/cpp/bindings/message.h"
 
 namespace IPC {
 namespace internal {
 
+namespace {
+
+// Messages at least this large are sent through a read-only shared memory
+// region. This replaces copying the payload into and out of the Mojo message,
+// and pushing it through the channel, with one copy on each side.
+constexpr size_t kSharedMemoryMessageThreshold = 256 * 1024;
+
+bool IsSharedMemoryMessage(const Message& message) {
+  return message.routing_id() == MSG_ROUTING_NONE &&
+         message.type() == Channel::SHARED_MEMORY_MESSAGE_TYPE;
+}
+
+// Returns a message carrying a copy of |message| in a read-only shared memory
+// region, followed by the attachments of |message|, or null if the region
+// couldn't be created.
+std::unique_ptr<Message> WrapInSharedMemory(Message* message) {
+#if defined(OS_POSIX) || defined(OS_FUCHSIA)
+  // The region needs a descriptor of its own.
+  if (message->HasAttachments() &&
+      message->attachment_set()->size() >=
+          MessageAttachmentSet::kMaxDescriptorsPerMessage) {
+    return nullptr;
+  }
+#endif
+
+  base::MappedReadOnlyRegion shm =
+      base::ReadOnlySharedMemoryRegion::Create(message->size());
+  if (!shm.IsValid())
+    return nullptr;
+  memcpy(shm.mapping.memory(), message->data(), message->size());
+
+  auto wrapper = std::make_unique<Message>(MSG_ROUTING_NONE,
+                                           Channel::SHARED_MEMORY_MESSAGE_TYPE,
+                                           Message::PRIORITY_NORMAL);
+  WriteParam(wrapper.get(), std::move(shm.region));
+
+  uint32_t num_attachments = 0;
+  if (message->HasAttachments()) {
+    MessageAttachmentSet* set = message->attachment_set();
+    num_attachments = set->size();
+    for (unsigned i = 0; i < num_attachments; ++i) {
+      bool ok = wrapper->attachment_set()->AddAttachment(
+          set->GetAttachmentAt(i));
+      DCHECK(ok);
+    }
+    set->CommitAllDescriptors();
+  }
+  wrapper->WriteUInt32(num_attachments);
+  return wrapper;
+}
+
+// Reverses WrapInSharedMemory(). Returns null if |wrapper| is malformed. Like
+// other received messages, the returned message doesn't own its data: it
+// points into |storage|, which receives a copy of the region's contents.
+std::unique_ptr<Message> UnwrapFromSharedMemory(Message* wrapper,
+                                                std::vector<char>* storage) {
+  // A read-only region is carried by exactly one attachment on every platform.
+  constexpr unsigned kRegionAttachments = 1;
+
+  base::PickleIterator iter(*wrapper);
+  base::ReadOnlySharedMemoryRegion region;
+  uint32_t num_attachments = 0;
+  if (!ReadParam(wrapper, &iter, &region) ||
+      !iter.ReadUInt32(&num_attachments)) {
+    return nullptr;
+  }
+
+  // The wrapper must carry the region's handle followed by exactly the
+  // wrapped message's attachments.
+  MessageAttachmentSet* set = wrapper->attachment_set();
+  if (!region.IsValid() || set->size() < kRegionAttachments ||
+      num_attachments != set->size() - kRegionAttachments) {
+    return nullptr;
+  }
+
+  // Bound the region before mapping it, so a sender can't make us map an
+  // arbitrarily large one.
+  if (region.GetSize() > Channel::kMaximumMessageSize)
+    return nullptr;
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return nullptr;
+
+  // Copy the message out of the mapping before validating it, so the sender
+  // can't change it afterwards.
+  const char* data = static_cast<const char*>(mapping.memory());
+  storage->assign(data, data + mapping.size());
+  auto message = std::make_unique<Message>(
+      storage->data(), base::checked_cast<int>(storage->size()));
+  if (!message->IsValid() || IsSharedMemoryMessage(*message))
+    return nullptr;
+
+  for (unsigned i = kRegionAttachments; i < set->size(); ++i) {
+    scoped_refptr<MessageAttachment> attachment = set->GetAttachmentAt(i);
+    if (!attachment ||
+        !message->attachment_set()->AddAttachment(std::move(attachment))) {
+      return nullptr;
+    }
+  }
+  return message;
+}
+
+}  // namespace
+
 MessagePipeReader::MessagePipeReader(
     mojo::MessagePipeHandle pipe,
     mojo::AssociatedRemote<mojom::Channel> sender,
@@ -54,6 +165,12 @@ bool MessagePipeReader::Send(std::unique_ptr<Message> message) {
   TRACE_EVENT_WITH_FLOW0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
                          "MessagePipeReader::Send", message->flags(),
                          TRACE_EVENT_FLAG_FLOW_OUT);
+  if (message->size() >= kSharedMemoryMessageThreshold) {
+    // Fall back to sending the message inline if the region can't be created.
+    std::unique_ptr<Message> wrapper = WrapInSharedMemory(message.get());
+    if (wrapper)
+      message = std::move(wrapper);
+  }
   base::Optional<std::vector<mojo::native::SerializedHandlePtr>> handles;
   MojoResult result = MOJO_RESULT_OK;
   result = ChannelMojo::ReadFromMessageAttachmentSet(message.get(), &handles);
@@ -101,6 +218,21 @@ void MessagePipeReader::Receive(MessageView message_view) {
     return;
   }
 
+  if (IsSharedMemoryMessage(message)) {
+    std::vector<char> storage;
+    std::unique_ptr<Message> unwrapped =
+        UnwrapFromSharedMemory(&message, &storage);
+    if (!unwrapped) {
+      delegate_->OnBrokenDataReceived();
+      return;
+    }
+    ForwardReceivedMessage(*unwrapped);
+    return;
+  }
+  ForwardReceivedMessage(message);
+}
+
+void MessagePipeReader::ForwardReceivedMessage(const Message& message) {
   TRACE_EVENT_WITH_FLOW0(TRACE_DISABLED_BY_DEFAULT("toplevel.flow"),
                          "MessagePipeReader::Receive", message.flags(),
                          TRACE_EVENT_FLAG_FLOW_IN);
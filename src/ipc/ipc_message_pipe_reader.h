@@ -80,7 +80,8 @@ class COMPONENT_EXPORT(IPC) MessagePipeReader : public mojom::Channel {
   bool IsValid() { return sender_.is_bound(); }
 
   // Sends an IPC::Message to the other end of the pipe. Safe to call from any
-  // thread.
+  // thread. Large messages are sent through a read-only shared memory region
+  // and unwrapped again by the receiving MessagePipeReader.
   bool Send(std::unique_ptr<Message> message);
 
   // Requests an associated interface from the other end of the pipe.
@@ -102,6 +103,8 @@ class COMPONENT_EXPORT(IPC) MessagePipeReader : public mojom::Channel {
       mojo::PendingAssociatedReceiver<mojom::GenericInterface> receiver)
       override;
 
+  void ForwardReceivedMessage(const Message& message);
+
   // |delegate_| is null once the message pipe is closed.
   Delegate* delegate_;
   mojo::AssociatedRemote<mojom::Channel> sender_;
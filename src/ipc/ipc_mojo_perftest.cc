@@ -173,6 +173,15 @@ std::vector<PingPongTestParams> GetDefaultTestParams() {
   return list;
 }
 
+// Sizes at which legacy IPC messages are sent through shared memory.
+std::vector<PingPongTestParams> GetLargeMessageTestParams() {
+  std::vector<PingPongTestParams> list;
+  list.push_back(PingPongTestParams(64 * 1024, 20 * kMultiplier));
+  list.push_back(PingPongTestParams(1024 * 1024, 2 * kMultiplier));
+  list.push_back(PingPongTestParams(16 * 1024 * 1024, 10));
+  return list;
+}
+
 std::vector<InterfacePassingTestParams> GetDefaultInterfacePassingTestParams() {
   std::vector<InterfacePassingTestParams> list;
   list.push_back({500 * kMultiplier, 0});
@@ -188,7 +197,8 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
   MojoChannelPerfTest() = default;
   ~MojoChannelPerfTest() override = default;
 
-  void RunTestChannelProxyPingPong() {
+  void RunTestChannelProxyPingPong(
+      const std::vector<PingPongTestParams>& params) {
     Init("MojoPerfTestClient");
 
     // Set up IPC channel and start client.
@@ -199,7 +209,6 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
     listener.Init(channel_proxy.get());
 
     LockThreadAffinity thread_locker(kSharedCore);
-    std::vector<PingPongTestParams> params = GetDefaultTestParams();
     for (size_t i = 0; i < params.size(); i++) {
       listener.SetTestParams(params[i].message_count(),
                              params[i].message_size(), false);
@@ -254,7 +263,14 @@ class MojoChannelPerfTest : public IPCChannelMojoTestBase {
 };
 
 TEST_F(MojoChannelPerfTest, ChannelProxyPingPong) {
-  RunTestChannelProxyPingPong();
+  RunTestChannelProxyPingPong(GetDefaultTestParams());
+
+  base::RunLoop run_loop;
+  run_loop.RunUntilIdle();
+}
+
+TEST_F(MojoChannelPerfTest, ChannelProxyLargeMessagePingPong) {
+  RunTestChannelProxyPingPong(GetLargeMessageTestParams());
 
   base::RunLoop run_loop;
   run_loop.RunUntilIdle();
@@ -23,6 +23,12 @@ const base::Feature kAudioServiceOutOfProcessKillAtHang{
 const base::Feature kDumpOnAudioServiceHang{"DumpOnAudioServiceHang",
                                             base::FEATURE_DISABLED_BY_DEFAULT};
 
+// If enabled, the audio service mixes output streams with identical parameters
+// that play to the same device into a single physical stream, instead of
+// relying on the platform to mix them.
+const base::Feature kAudioServiceOutputDeviceMixer{
+    "AudioServiceOutputDeviceMixer", base::FEATURE_DISABLED_BY_DEFAULT};
+
 #if defined(OS_ANDROID)
 // Enables loading and using AAudio instead of OpenSLES on compatible devices,
 // for audio output streams.
@@ -13,6 +13,7 @@ namespace features {
 
 MEDIA_EXPORT extern const base::Feature kAudioServiceOutOfProcessKillAtHang;
 MEDIA_EXPORT extern const base::Feature kDumpOnAudioServiceHang;
+MEDIA_EXPORT extern const base::Feature kAudioServiceOutputDeviceMixer;
 
 #if defined(OS_ANDROID)
 MEDIA_EXPORT extern const base::Feature kUseAAudioDriver;
@@ -175,8 +175,11 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
                fifo_frame_delay);
   const bool needs_downmix = channel_mixer_ && downmix_early_;
 
-  if (!mixer_input_audio_bus_ ||
-      mixer_input_audio_bus_->frames() != dest->frames()) {
+  // Only the second and subsequent inputs need a scratch buffer; the first one
+  // is rendered directly into the destination.
+  if (transform_inputs_.size() > 1 &&
+      (!mixer_input_audio_bus_ ||
+       mixer_input_audio_bus_->frames() != dest->frames())) {
     mixer_input_audio_bus_ =
         AudioBus::Create(input_channel_count_, dest->frames());
   }
@@ -190,8 +193,9 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
   AudioBus* const temp_dest = needs_downmix ? unmixed_audio_.get() : dest;
 
   // Sanity check our inputs.
-  DCHECK_EQ(temp_dest->frames(), mixer_input_audio_bus_->frames());
-  DCHECK_EQ(temp_dest->channels(), mixer_input_audio_bus_->channels());
+  DCHECK_EQ(temp_dest->channels(), input_channel_count_);
+  DCHECK(transform_inputs_.size() == 1 ||
+         temp_dest->frames() == mixer_input_audio_bus_->frames());
 
   // |total_frames_delayed| is reported to the *input* source in terms of the
   // *input* sample rate. |initial_frames_delayed_| is given in terms of the
@@ -209,24 +213,21 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
     total_frames_delayed += fifo_frame_delay;
   }
 
-  // If we only have a single input, avoid an extra copy.
-  AudioBus* const provide_input_dest =
-      transform_inputs_.size() == 1 ? temp_dest : mixer_input_audio_bus_.get();
-
   // Have each mixer render its data into an output buffer then mix the result.
+  // The first input renders directly into |temp_dest| so the common single
+  // input case, and the first of many inputs, avoid an extra copy.
   for (auto* input : transform_inputs_) {
-    const float volume =
-        input->ProvideInput(provide_input_dest, total_frames_delayed);
-    // Optimize the most common single input, full volume case.
     if (input == transform_inputs_.front()) {
-      if (volume == 1.0f) {
-        if (temp_dest != provide_input_dest)
-          provide_input_dest->CopyTo(temp_dest);
-      } else if (volume > 0) {
-        for (int i = 0; i < provide_input_dest->channels(); ++i) {
-          vector_math::FMUL(
-              provide_input_dest->channel(i), volume,
-              provide_input_dest->frames(), temp_dest->channel(i));
+      const float volume = input->ProvideInput(temp_dest, total_frames_delayed);
+      // Optimize the most common full volume case.
+      if (volume == 1.0f)
+        continue;
+
+      if (volume > 0) {
+        // Volume adjust in place; vector_math::FMUL() supports |src| == |dest|.
+        for (int i = 0; i < temp_dest->channels(); ++i) {
+          vector_math::FMUL(temp_dest->channel(i), volume, temp_dest->frames(),
+                            temp_dest->channel(i));
         }
       } else {
         // Zero |temp_dest| otherwise, so we're mixing into a clean buffer.
@@ -236,6 +237,9 @@ void AudioConverter::SourceCallback(int fifo_frame_delay, AudioBus* dest) {
       continue;
     }
 
+    const float volume =
+        input->ProvideInput(mixer_input_audio_bus_.get(), total_frames_delayed);
+
     // Volume adjust and mix each mixer input into |temp_dest| after rendering.
     if (volume > 0) {
       for (int i = 0; i < mixer_input_audio_bus_->channels(); ++i) {
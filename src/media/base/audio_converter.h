@@ -133,7 +133,8 @@ class MEDIA_EXPORT AudioConverter {
   std::unique_ptr<ChannelMixer> channel_mixer_;
   std::unique_ptr<AudioBus> unmixed_audio_;
 
-  // Temporary AudioBus destination for mixing inputs.
+  // Temporary AudioBus destination for mixing inputs.  Only allocated when
+  // there is more than one input, since the first input renders in place.
   std::unique_ptr<AudioBus> mixer_input_audio_bus_;
 
   // Since resampling is expensive, figure out if we should downmix channels
@@ -153,12 +153,12 @@ void AudioRendererMixer::RemoveMixerInput(
 }
 
 void AudioRendererMixer::AddErrorCallback(AudioRendererMixerInput* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_callbacks_lock_);
   error_callbacks_.insert(input);
 }
 
 void AudioRendererMixer::RemoveErrorCallback(AudioRendererMixerInput* input) {
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_callbacks_lock_);
   error_callbacks_.erase(input);
 }
 
@@ -204,7 +204,7 @@ int AudioRendererMixer::Render(base::TimeDelta delay,
 
 void AudioRendererMixer::OnRenderError() {
   // Call each mixer input and signal an error.
-  base::AutoLock auto_lock(lock_);
+  base::AutoLock auto_lock(error_callbacks_lock_);
   for (auto* input : error_callbacks_)
     input->OnRenderError();
 }
@@ -90,12 +90,16 @@ class MEDIA_EXPORT AudioRendererMixer
   // Task Runner used by |muted_suspender_|.
   scoped_refptr<base::SingleThreadTaskRunner> suspender_task_runner_;
 
+  // List of error callbacks used by this mixer.  These have their own lock
+  // since they are registered for every input, whether playing or not, and
+  // shouldn't contend with Render() on the audio device thread.
+  base::Lock error_callbacks_lock_;
+  base::flat_set<AudioRendererMixerInput*> error_callbacks_
+      GUARDED_BY(error_callbacks_lock_);
+
   // ---------------[ All variables below protected by |lock_| ]---------------
   base::Lock lock_;
 
-  // List of error callbacks used by this mixer.
-  base::flat_set<AudioRendererMixerInput*> error_callbacks_ GUARDED_BY(lock_);
-
   // Maps input sample rate to the dedicated converter.
   using AudioConvertersMap =
       base::flat_map<int, std::unique_ptr<LoopbackAudioConverter>>;
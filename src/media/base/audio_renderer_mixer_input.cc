@@ -119,8 +119,7 @@ void AudioRendererMixerInput::Pause() {
 void AudioRendererMixerInput::Flush() {}
 
 bool AudioRendererMixerInput::SetVolume(double volume) {
-  base::AutoLock auto_lock(volume_lock_);
-  volume_ = volume;
+  volume_.store(volume, std::memory_order_relaxed);
   return true;
 }
 
@@ -228,10 +227,7 @@ double AudioRendererMixerInput::ProvideInput(AudioBus* audio_bus,
   // We're reading |volume_| from the audio device thread and must avoid racing
   // with the main/media thread calls to SetVolume(). See thread safety comment
   // in the header file.
-  {
-    base::AutoLock auto_lock(volume_lock_);
-    return frames_filled > 0 ? volume_ : 0;
-  }
+  return frames_filled > 0 ? volume_.load(std::memory_order_relaxed) : 0;
 }
 
 void AudioRendererMixerInput::OnRenderError() {
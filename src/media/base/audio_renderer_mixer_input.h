@@ -9,19 +9,19 @@
 // to this object across the main thread (for WebAudio APIs) and the
 // media thread (for HTMLMediaElement APIs).
 //
-// The one exception is protection for |volume_| via |volume_lock_|. This lock
-// prevents races between SetVolume() (called on any thread) and ProvideInput
-// (called on audio device thread). See http://crbug.com/588992.
+// The one exception is |volume_|, which is atomic to prevent races between
+// SetVolume() (called on any thread) and ProvideInput (called on audio device
+// thread) without taking a lock on the realtime thread for every input. See
+// http://crbug.com/588992.
 
 #ifndef MEDIA_BASE_AUDIO_RENDERER_MIXER_INPUT_H_
 #define MEDIA_BASE_AUDIO_RENDERER_MIXER_INPUT_H_
 
+#include <atomic>
 #include <string>
 
 #include "base/callback.h"
 #include "base/macros.h"
-#include "base/synchronization/lock.h"
-#include "base/thread_annotations.h"
 #include "media/base/audio_converter.h"
 #include "media/base/audio_latency.h"
 #include "media/base/audio_renderer_sink.h"
@@ -73,13 +73,11 @@ class MEDIA_EXPORT AudioRendererMixerInput
   // Pool to obtain mixers from / return them to.
   AudioRendererMixerPool* const mixer_pool_;
 
-  // Protect |volume_|, accessed by separate threads in ProvideInput() and
-  // SetVolume().
-  base::Lock volume_lock_;
-
   bool started_ = false;
   bool playing_ = false;
-  double volume_ GUARDED_BY(volume_lock_) = 1.0;
+
+  // Accessed by separate threads in ProvideInput() and SetVolume().
+  std::atomic<double> volume_{1.0};
 
   scoped_refptr<AudioRendererSink> sink_;
   base::Optional<OutputDeviceInfo> device_info_;
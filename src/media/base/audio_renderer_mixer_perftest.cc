@@ -0,0 +1,118 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "media/base/audio_renderer_mixer.h"
+#include "media/base/fake_audio_render_callback.h"
+#include "media/base/mock_audio_renderer_sink.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+
+namespace {
+
+void LogUma(int value) {}
+
+// Number of Render() calls per benchmark run; ~20 seconds of audio at the
+// output parameters below.
+const int kBenchmarkIterations = 2000;
+
+const int kOutputSampleRate = 48000;
+const int kOutputBufferSize = 480;
+
+}  // namespace
+
+// Measures the time the audio device thread spends in AudioRendererMixer's
+// Render() callback as a function of the number of mixed inputs.  The results
+// are reported relative to the buffer duration, which is the deadline the
+// callback must meet to avoid glitches.
+class AudioRendererMixerPerfTest
+    : public testing::TestWithParam<std::tuple<int, bool>> {
+ public:
+  AudioRendererMixerPerfTest()
+      : output_params_(AudioParameters::AUDIO_PCM_LOW_LATENCY,
+                       CHANNEL_LAYOUT_STEREO,
+                       kOutputSampleRate,
+                       kOutputBufferSize),
+        sink_(new testing::NiceMock<MockAudioRendererSink>()) {}
+
+ protected:
+  base::test::TaskEnvironment task_environment_;
+  const AudioParameters output_params_;
+  scoped_refptr<testing::NiceMock<MockAudioRendererSink>> sink_;
+};
+
+TEST_P(AudioRendererMixerPerfTest, Render) {
+  const int input_count = std::get<0>(GetParam());
+  const bool mixed_sample_rates = std::get<1>(GetParam());
+
+  AudioRendererMixer mixer(output_params_, sink_,
+                           base::BindRepeating(&LogUma));
+  AudioRendererSink::RenderCallback* mixer_callback = sink_->callback();
+
+  // When |mixed_sample_rates| is set, every other input runs at 44.1 kHz so
+  // half of the inputs go through a resampling LoopbackAudioConverter.
+  std::vector<AudioParameters> input_params;
+  std::vector<std::unique_ptr<FakeAudioRenderCallback>> inputs;
+  for (int i = 0; i < input_count; ++i) {
+    const int sample_rate =
+        mixed_sample_rates && i % 2 ? 44100 : kOutputSampleRate;
+    input_params.emplace_back(AudioParameters::AUDIO_PCM_LINEAR,
+                              CHANNEL_LAYOUT_STEREO, sample_rate,
+                              kOutputBufferSize);
+    inputs.push_back(std::make_unique<FakeAudioRenderCallback>(
+        1.0 / kOutputBufferSize, sample_rate));
+    // Use a non-unity volume so the volume adjusted paths are measured.
+    inputs.back()->set_volume(0.5);
+    mixer.AddMixerInput(input_params.back(), inputs.back().get());
+  }
+
+  std::unique_ptr<AudioBus> audio_bus = AudioBus::Create(output_params_);
+  base::TimeDelta total_time;
+  base::TimeDelta max_time;
+  for (int i = 0; i < kBenchmarkIterations; ++i) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    mixer_callback->Render(base::TimeDelta(), start, 0, audio_bus.get());
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    total_time += elapsed;
+    max_time = std::max(max_time, elapsed);
+  }
+
+  for (int i = 0; i < input_count; ++i)
+    mixer.RemoveMixerInput(input_params[i], inputs[i].get());
+
+  const double deadline_us =
+      output_params_.GetBufferDuration().InMicrosecondsF();
+  perf_test::PerfResultReporter reporter(
+      "audio_renderer_mixer",
+      base::StringPrintf("%d_inputs%s", input_count,
+                         mixed_sample_rates ? "_mixed_rates" : ""));
+  reporter.RegisterImportantMetric("_render_time_avg", "us");
+  reporter.RegisterImportantMetric("_render_time_max", "us");
+  reporter.RegisterImportantMetric("_deadline_used_avg", "%");
+  reporter.RegisterImportantMetric("_deadline_used_max", "%");
+  const double avg_us = total_time.InMicrosecondsF() / kBenchmarkIterations;
+  reporter.AddResult("_render_time_avg", avg_us);
+  reporter.AddResult("_render_time_max", max_time.InMicrosecondsF());
+  reporter.AddResult("_deadline_used_avg", 100 * avg_us / deadline_us);
+  reporter.AddResult("_deadline_used_max",
+                     100 * max_time.InMicrosecondsF() / deadline_us);
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         AudioRendererMixerPerfTest,
+                         testing::Combine(testing::Values(1, 4, 10, 16),
+                                          testing::Bool()));
+
+}  // namespace media
@@ -78,11 +78,12 @@ void ByteQueue::Pop(int count) {
   offset_ += count;
   used_ -= count;
 
-  // Move the offset back to 0 if we have reached the end of the buffer.
-  if (offset_ == size_) {
-    DCHECK_EQ(used_, 0);
+  // Move the offset back to 0 once the queue has been drained.  Parsers often
+  // consume everything they were given, so this lets the next Push() append at
+  // the start of |buffer_| instead of memmove()ing or growing once the tail is
+  // reached.
+  if (used_ == 0)
     offset_ = 0;
-  }
 }
 
 uint8_t* ByteQueue::Front() const {
@@ -0,0 +1,60 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "media/base/byte_queue.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+
+static const int kBenchmarkBytes = 512 * 1024 * 1024;
+
+// Simulates a stream parser appending |append_size| bytes at a time and
+// consuming them in |pop_size| chunks, leaving any remainder queued for the
+// next append the way parsers do with partial boxes or elements.
+static void RunPushPopBenchmark(int append_size,
+                                int pop_size,
+                                const std::string& story) {
+  std::vector<uint8_t> data(append_size, 0xAB);
+  ByteQueue queue;
+
+  const int iterations = kBenchmarkBytes / append_size;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < iterations; ++i) {
+    queue.Push(data.data(), append_size);
+
+    const uint8_t* queue_data;
+    int queue_size;
+    queue.Peek(&queue_data, &queue_size);
+    while (queue_size >= pop_size) {
+      queue.Pop(pop_size);
+      queue.Peek(&queue_data, &queue_size);
+    }
+  }
+  const double total_time_seconds =
+      (base::TimeTicks::Now() - start).InSecondsF();
+
+  perf_test::PerfResultReporter reporter("byte_queue", story);
+  reporter.RegisterImportantMetric("_throughput", "MB/s");
+  reporter.AddResult("_throughput",
+                     kBenchmarkBytes / (1024.0 * 1024.0) / total_time_seconds);
+}
+
+TEST(ByteQueuePerfTest, PushPop) {
+  const int kAppendSizes[] = {4 * 1024, 64 * 1024, 1024 * 1024};
+  for (int append_size : kAppendSizes) {
+    // Consume everything, and consume in sizes that leave a remainder queued.
+    RunPushPopBenchmark(append_size, append_size,
+                        base::StringPrintf("append_%d_drain", append_size));
+    RunPushPopBenchmark(append_size, 3000,
+                        base::StringPrintf("append_%d_pop_3000", append_size));
+  }
+}
+
+}  // namespace media
@@ -4,14 +4,33 @@
 
 #include "media/base/demuxer_memory_limit.h"
 
+#include "base/system/sys_info.h"
+
 namespace media {
 
+namespace {
+
+// Low-end devices (512MiB of RAM or less, or running with
+// --enable-low-end-device-mode) can't afford the default limits for every
+// player that may be alive at once, so they get the low limits instead.
+size_t SelectLimit(size_t default_limit, size_t low_limit) {
+  return base::SysInfo::IsLowEndDevice() ? low_limit : default_limit;
+}
+
+}  // namespace
+
 size_t GetDemuxerStreamAudioMemoryLimit() {
-  return internal::kDemuxerStreamAudioMemoryLimitDefault;
+  static const size_t limit =
+      SelectLimit(internal::kDemuxerStreamAudioMemoryLimitDefault,
+                  internal::kDemuxerStreamAudioMemoryLimitLow);
+  return limit;
 }
 
 size_t GetDemuxerStreamVideoMemoryLimit() {
-  return internal::kDemuxerStreamVideoMemoryLimitDefault;
+  static const size_t limit =
+      SelectLimit(internal::kDemuxerStreamVideoMemoryLimitDefault,
+                  internal::kDemuxerStreamVideoMemoryLimitLow);
+  return limit;
 }
 
 size_t GetDemuxerMemoryLimit() {
@@ -92,20 +92,33 @@ class MEDIA_EXPORT SincResampler {
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_unoptimized_aligned);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_optimized_aligned);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_optimized_unaligned);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_avx2_aligned);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_avx2_unaligned);
 
   void InitializeKernel();
   void UpdateRegions(bool second_load);
 
   // Compute convolution of |k1| and |k2| over |input_ptr|, resultant sums are
   // linearly interpolated using |kernel_interpolation_factor|.  On x86, the
-  // underlying implementation is chosen at run time based on SSE support.  On
-  // ARM, NEON support is chosen at compile time based on compilation flags.
+  // underlying implementation is chosen at run time based on AVX2 and FMA3
+  // support, falling back to SSE.  On ARM, NEON support is chosen at compile
+  // time based on compilation flags.
+  using ConvolveProc = float (*)(const float* input_ptr,
+                                 const float* k1,
+                                 const float* k2,
+                                 double kernel_interpolation_factor);
+  static ConvolveProc GetConvolveProc();
   static float Convolve_C(const float* input_ptr, const float* k1,
                           const float* k2, double kernel_interpolation_factor);
 #if defined(ARCH_CPU_X86_FAMILY)
   static float Convolve_SSE(const float* input_ptr, const float* k1,
                             const float* k2,
                             double kernel_interpolation_factor);
+  // Requires |k1| and |k2| to be 32-byte aligned.
+  static float Convolve_AVX2(const float* input_ptr,
+                             const float* k1,
+                             const float* k2,
+                             double kernel_interpolation_factor);
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
   static float Convolve_NEON(const float* input_ptr, const float* k1,
                              const float* k2,
@@ -125,6 +138,9 @@ class MEDIA_EXPORT SincResampler {
   // Source of data for resampling.
   const ReadCB read_cb_;
 
+  // The Convolve_* implementation selected for this CPU.
+  const ConvolveProc convolve_proc_;
+
   // The size (in samples) to request from each |read_cb_| execution.
   const int request_frames_;
 
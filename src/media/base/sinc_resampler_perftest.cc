@@ -2,10 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <memory>
+#include <tuple>
+
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/cpu.h"
+#include "base/strings/stringprintf.h"
 #include "base/time/time.h"
 #include "build/build_config.h"
+#include "media/base/audio_bus.h"
+#include "media/base/multi_channel_resampler.h"
 #include "media/base/sinc_resampler.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -62,6 +70,83 @@ TEST(SincResamplerPerfTest, Convolve_optimized_unaligned) {
 }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY)
+TEST(SincResamplerPerfTest, Convolve_avx2_aligned) {
+  base::CPU cpu;
+  if (!cpu.has_avx2() || !cpu.has_fma3())
+    return;
+  RunConvolveBenchmark(SincResampler::Convolve_AVX2, true, "avx2_aligned");
+}
+
+TEST(SincResamplerPerfTest, Convolve_avx2_unaligned) {
+  base::CPU cpu;
+  if (!cpu.has_avx2() || !cpu.has_fma3())
+    return;
+  RunConvolveBenchmark(SincResampler::Convolve_AVX2, false, "avx2_unaligned");
+}
+#endif
+
 #undef CONVOLVE_FUNC
 
+static const int kResampleBenchmarkSeconds = 60;
+static const int kResampleFramesPerBuffer = 480;
+
+struct ResampleRates {
+  int input_sample_rate;
+  int output_sample_rate;
+};
+
+class MultiChannelResamplerPerfTest
+    : public testing::TestWithParam<std::tuple<ResampleRates, int>> {
+ public:
+  void ProvideInput(int frame_delay, AudioBus* audio_bus) {
+    // Real content isn't needed; the convolution cost doesn't depend on the
+    // sample values.  Avoid silence so denormal handling isn't measured.
+    for (int ch = 0; ch < audio_bus->channels(); ++ch)
+      std::fill_n(audio_bus->channel(ch), audio_bus->frames(), 0.5f);
+  }
+};
+
+// Measures how fast real time audio can be resampled for the common sample
+// rate conversions seen when mixing streams for an output device.
+TEST_P(MultiChannelResamplerPerfTest, Resample) {
+  const ResampleRates rates = std::get<0>(GetParam());
+  const int channels = std::get<1>(GetParam());
+  const double io_ratio =
+      static_cast<double>(rates.input_sample_rate) / rates.output_sample_rate;
+
+  MultiChannelResampler resampler(
+      channels, io_ratio, SincResampler::kDefaultRequestSize,
+      base::BindRepeating(&MultiChannelResamplerPerfTest::ProvideInput,
+                          base::Unretained(this)));
+  std::unique_ptr<AudioBus> output =
+      AudioBus::Create(channels, kResampleFramesPerBuffer);
+
+  const int iterations = kResampleBenchmarkSeconds *
+                         rates.output_sample_rate / kResampleFramesPerBuffer;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < iterations; ++i)
+    resampler.Resample(output->frames(), output.get());
+  double total_time_seconds = (base::TimeTicks::Now() - start).InSecondsF();
+
+  perf_test::PerfResultReporter reporter(
+      "multi_channel_resampler",
+      base::StringPrintf("%d_to_%d_%dch", rates.input_sample_rate,
+                         rates.output_sample_rate, channels));
+  reporter.RegisterImportantMetric("_realtime_factor", "x");
+  reporter.AddResult("_realtime_factor",
+                     kResampleBenchmarkSeconds / total_time_seconds);
+}
+
+static const ResampleRates kResampleRates[] = {
+    {44100, 48000},
+    {48000, 44100},
+    {8000, 48000},
+};
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         MultiChannelResamplerPerfTest,
+                         testing::Combine(testing::ValuesIn(kResampleRates),
+                                          testing::Values(1, 2, 6)));
+
 } // namespace media
@@ -12,7 +12,10 @@
 
 // NaCl does not allow intrinsics.
 #if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <immintrin.h>
 #include <xmmintrin.h>
+
+#include "base/cpu.h"
 // Don't use custom SSE versions where the auto-vectorized C version performs
 // better, which is anywhere clang is used.
 // TODO(pcc): Linux currently uses ThinLTO which has broken auto-vectorization
@@ -39,10 +42,32 @@
 namespace media {
 namespace vector_math {
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+namespace {
+
+// The AVX2 variants also require FMA3, which every AVX2 capable CPU shipped to
+// date provides; check both to be safe.  The result is computed once since
+// CPUID is comparatively expensive and these functions run on the realtime
+// audio thread.
+bool HasAVX2AndFMA3() {
+  static const bool has_avx2_and_fma3 = [] {
+    base::CPU cpu;
+    return cpu.has_avx2() && cpu.has_fma3();
+  }();
+  return has_avx2_and_fma3;
+}
+
+}  // namespace
+#endif
+
 void FMAC(const float src[], float scale, int len, float dest[]) {
   // Ensure |src| and |dest| are 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(dest) & (kRequiredAlignment - 1));
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  if (HasAVX2AndFMA3())
+    return FMAC_AVX2(src, scale, len, dest);
+#endif
   return FMAC_FUNC(src, scale, len, dest);
 }
 
@@ -55,6 +80,10 @@ void FMUL(const float src[], float scale, int len, float dest[]) {
   // Ensure |src| and |dest| are 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(dest) & (kRequiredAlignment - 1));
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  if (HasAVX2AndFMA3())
+    return FMUL_AVX2(src, scale, len, dest);
+#endif
   return FMUL_FUNC(src, scale, len, dest);
 }
 
@@ -67,6 +96,11 @@ std::pair<float, float> EWMAAndMaxPower(
     float initial_value, const float src[], int len, float smoothing_factor) {
   // Ensure |src| is 16-byte aligned.
   DCHECK_EQ(0u, reinterpret_cast<uintptr_t>(src) & (kRequiredAlignment - 1));
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  if (HasAVX2AndFMA3()) {
+    return EWMAAndMaxPower_AVX2(initial_value, src, len, smoothing_factor);
+  }
+#endif
   return EWMAAndMaxPower_FUNC(initial_value, src, len, smoothing_factor);
 }
 
@@ -187,6 +221,105 @@ std::pair<float, float> EWMAAndMaxPower_SSE(
 
   return result;
 }
+// The AVX2 variants are compiled with function level target attributes so the
+// rest of the file (and binary) can still run on CPUs without AVX2; callers
+// must check for AVX2 and FMA3 support before using them.  Loads and stores
+// are unaligned since |kRequiredAlignment| only guarantees 16-byte alignment.
+__attribute__((target("avx2,fma"))) void FMUL_AVX2(const float src[],
+                                                   float scale,
+                                                   int len,
+                                                   float dest[]) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  const __m256 m_scale = _mm256_set1_ps(scale);
+  for (int i = 0; i < last_index; i += 8) {
+    _mm256_storeu_ps(dest + i,
+                     _mm256_mul_ps(_mm256_loadu_ps(src + i), m_scale));
+  }
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    dest[i] = src[i] * scale;
+}
+
+__attribute__((target("avx2,fma"))) void FMAC_AVX2(const float src[],
+                                                   float scale,
+                                                   int len,
+                                                   float dest[]) {
+  const int rem = len % 8;
+  const int last_index = len - rem;
+  const __m256 m_scale = _mm256_set1_ps(scale);
+  for (int i = 0; i < last_index; i += 8) {
+    _mm256_storeu_ps(dest + i,
+                     _mm256_fmadd_ps(_mm256_loadu_ps(src + i), m_scale,
+                                     _mm256_loadu_ps(dest + i)));
+  }
+
+  // Handle any remaining values that wouldn't fit in an AVX pass.
+  for (int i = last_index; i < len; ++i)
+    dest[i] += src[i] * scale;
+}
+
+__attribute__((target("avx2,fma"))) std::pair<float, float>
+EWMAAndMaxPower_AVX2(float initial_value,
+                     const float src[],
+                     int len,
+                     float smoothing_factor) {
+  // Same strategy as EWMAAndMaxPower_SSE(), but with 8 lanes of evaluation:
+  // z[n] through z[n-7] are computed in lanes 7 through 0, respectively, and
+  // combined as y[n] = z[n] + (1-a)^1(z[n-1]) + ... + (1-a)^7(z[n-7]).
+  const int rem = len % 8;
+  const int last_index = len - rem;
+
+  const __m256 smoothing_factor_x8 = _mm256_set1_ps(smoothing_factor);
+  const float weight_prev = 1.0f - smoothing_factor;
+  const float weight_prev_squared = weight_prev * weight_prev;
+  const float weight_prev_4th = weight_prev_squared * weight_prev_squared;
+  const __m256 weight_prev_8th_x8 =
+      _mm256_set1_ps(weight_prev_4th * weight_prev_4th);
+
+  __m256 max_x8 = _mm256_setzero_ps();
+  __m256 ewma_x8 = _mm256_setr_ps(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                  initial_value);
+  int i;
+  for (i = 0; i < last_index; i += 8) {
+    ewma_x8 = _mm256_mul_ps(ewma_x8, weight_prev_8th_x8);
+    const __m256 sample_x8 = _mm256_loadu_ps(src + i);
+    const __m256 sample_squared_x8 = _mm256_mul_ps(sample_x8, sample_x8);
+    max_x8 = _mm256_max_ps(max_x8, sample_squared_x8);
+    ewma_x8 = _mm256_fmadd_ps(sample_squared_x8, smoothing_factor_x8, ewma_x8);
+  }
+
+  // y[n] = z[n] + (1-a)^1(z[n-1]) + ... + (1-a)^7(z[n-7])
+  alignas(32) float ewma_lanes[8];
+  _mm256_store_ps(ewma_lanes, ewma_x8);
+  float ewma = ewma_lanes[7];
+  float weight = weight_prev;
+  for (int lane = 6; lane >= 0; --lane) {
+    ewma += ewma_lanes[lane] * weight;
+    weight *= weight_prev;
+  }
+
+  // Fold the maximums together to get the overall maximum.
+  __m128 max_x4 = _mm_max_ps(_mm256_castps256_ps128(max_x8),
+                             _mm256_extractf128_ps(max_x8, 1));
+  max_x4 = _mm_max_ps(max_x4,
+                      _mm_shuffle_ps(max_x4, max_x4, _MM_SHUFFLE(3, 3, 1, 1)));
+  max_x4 = _mm_max_ss(max_x4, _mm_shuffle_ps(max_x4, max_x4, 2));
+
+  std::pair<float, float> result(ewma, _mm_cvtss_f32(max_x4));
+
+  // Handle remaining values at the end of |src|.
+  for (; i < len; ++i) {
+    result.first *= weight_prev;
+    const float sample = src[i];
+    const float sample_squared = sample * sample;
+    result.first += sample_squared * smoothing_factor;
+    result.second = std::max(result.second, sample_squared);
+  }
+
+  return result;
+}
 #endif
 
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
@@ -4,6 +4,8 @@
 
 #include "media/base/video_frame_pool.h"
 
+#include <vector>
+
 #include "base/bind.h"
 #include "base/containers/circular_deque.h"
 #include "base/macros.h"
@@ -81,24 +83,34 @@ scoped_refptr<VideoFrame> VideoFramePool::PoolImpl::CreateFrame(
     const gfx::Rect& visible_rect,
     const gfx::Size& natural_size,
     base::TimeDelta timestamp) {
-  base::AutoLock auto_lock(lock_);
-  DCHECK(!is_shutdown_);
-
   scoped_refptr<VideoFrame> frame;
-  while (!frames_.empty()) {
-    scoped_refptr<VideoFrame> pool_frame = std::move(frames_.back().frame);
-    frames_.pop_back();
-
-    if (pool_frame->IsSameAllocation(format, coded_size, visible_rect,
-                                     natural_size)) {
-      frame = pool_frame;
-      frame->set_timestamp(timestamp);
-      frame->metadata()->Clear();
-      break;
+
+  // Frames which don't match the requested allocation are released after the
+  // lock is dropped, as is allocation of a new frame, so that threads returning
+  // frames via FrameReleased() don't wait on freeing or zeroing a large buffer.
+  std::vector<scoped_refptr<VideoFrame>> frames_to_release;
+  {
+    base::AutoLock auto_lock(lock_);
+    DCHECK(!is_shutdown_);
+
+    while (!frames_.empty()) {
+      scoped_refptr<VideoFrame> pool_frame = std::move(frames_.back().frame);
+      frames_.pop_back();
+
+      if (pool_frame->IsSameAllocation(format, coded_size, visible_rect,
+                                       natural_size)) {
+        frame = std::move(pool_frame);
+        break;
+      }
+      frames_to_release.push_back(std::move(pool_frame));
     }
   }
+  frames_to_release.clear();
 
-  if (!frame) {
+  if (frame) {
+    frame->set_timestamp(timestamp);
+    frame->metadata()->Clear();
+  } else {
     frame = VideoFrame::CreateZeroInitializedFrame(
         format, coded_size, visible_rect, natural_size, timestamp);
     // This can happen if the arguments are not valid.
@@ -122,24 +134,30 @@ void VideoFramePool::PoolImpl::Shutdown() {
 }
 
 void VideoFramePool::PoolImpl::FrameReleased(scoped_refptr<VideoFrame> frame) {
-  base::AutoLock auto_lock(lock_);
-  if (is_shutdown_)
-    return;
-
-  const base::TimeTicks now = tick_clock_->NowTicks();
-  frames_.push_back({now, std::move(frame)});
-
-  // After this loop, |stale_index| is the index of the oldest non-stale frame.
-  // Such an index must exist because |frame| is never stale.
-  int stale_index = -1;
-  constexpr base::TimeDelta kStaleFrameLimit = base::TimeDelta::FromSeconds(10);
-  while (now - frames_[++stale_index].last_use_time > kStaleFrameLimit) {
-    // Last frame should never be included since we just added it.
-    DCHECK_LE(static_cast<size_t>(stale_index), frames_.size());
-  }
+  // Stale frames are destroyed after |lock_| is released; see CreateFrame().
+  std::vector<scoped_refptr<VideoFrame>> stale_frames;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (is_shutdown_)
+      return;
+
+    const base::TimeTicks now = tick_clock_->NowTicks();
+    frames_.push_back({now, std::move(frame)});
+
+    // After this loop, |stale_index| is the index of the oldest non-stale
+    // frame. Such an index must exist because |frame| is never stale.
+    int stale_index = -1;
+    constexpr base::TimeDelta kStaleFrameLimit =
+        base::TimeDelta::FromSeconds(10);
+    while (now - frames_[++stale_index].last_use_time > kStaleFrameLimit) {
+      // Last frame should never be included since we just added it.
+      DCHECK_LE(static_cast<size_t>(stale_index), frames_.size());
+      stale_frames.push_back(std::move(frames_[stale_index].frame));
+    }
 
-  if (stale_index)
-    frames_.erase(frames_.begin(), frames_.begin() + stale_index);
+    if (stale_index)
+      frames_.erase(frames_.begin(), frames_.begin() + stale_index);
+  }
 }
 
 VideoFramePool::VideoFramePool() : pool_(new PoolImpl()) {}
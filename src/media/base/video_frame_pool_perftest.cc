@@ -0,0 +1,54 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+
+#include "base/containers/circular_deque.h"
+#include "base/time/time.h"
+#include "media/base/video_frame_pool.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+
+static const int kBenchmarkFrames = 2000;
+
+// Roughly the number of frames a software decoder, VideoRendererImpl's ready
+// queue and the compositor keep alive at once during playback.
+static const size_t kFramesInFlight = 8;
+
+// Simulates a software decoder producing frames from |pool| while older frames
+// are released in decode order, as they are once rendered.
+static void RunCreateFrameBenchmark(const gfx::Size& size,
+                                    const std::string& story) {
+  VideoFramePool pool;
+  base::circular_deque<scoped_refptr<VideoFrame>> frames_in_flight;
+
+  base::TimeDelta total_time;
+  for (int i = 0; i < kBenchmarkFrames; ++i) {
+    const base::TimeTicks start = base::TimeTicks::Now();
+    scoped_refptr<VideoFrame> frame = pool.CreateFrame(
+        PIXEL_FORMAT_I420, size, gfx::Rect(size), size,
+        base::TimeDelta::FromMilliseconds(i * 16));
+    total_time += base::TimeTicks::Now() - start;
+    ASSERT_TRUE(frame);
+
+    frames_in_flight.push_back(std::move(frame));
+    if (frames_in_flight.size() > kFramesInFlight)
+      frames_in_flight.pop_front();
+  }
+
+  perf_test::PerfResultReporter reporter("video_frame_pool", story);
+  reporter.RegisterImportantMetric("_create_frame_time", "us");
+  reporter.AddResult("_create_frame_time",
+                     total_time.InMicrosecondsF() / kBenchmarkFrames);
+}
+
+TEST(VideoFramePoolPerfTest, CreateFrame) {
+  RunCreateFrameBenchmark(gfx::Size(1920, 1080), "1080p");
+  RunCreateFrameBenchmark(gfx::Size(3840, 2160), "2160p");
+}
+
+}  // namespace media
@@ -7,8 +7,9 @@
 
 #include <stddef.h>
 
-#include <map>
+#include <memory>
 
+#include "base/containers/flat_map.h"
 #include "base/files/file.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -81,8 +82,10 @@ class CAPTURE_EXPORT VideoCaptureBufferPoolImpl
   // The ID of the next buffer.
   int next_buffer_id_;
 
-  // The buffers, indexed by the first parameter, a buffer id.
-  std::map<int, std::unique_ptr<VideoCaptureBufferTracker>> trackers_;
+  // The buffers, indexed by the first parameter, a buffer id. A pool only
+  // holds a handful of buffers and ids only increase, so new trackers are
+  // appended at the end of the flat_map.
+  base::flat_map<int, std::unique_ptr<VideoCaptureBufferTracker>> trackers_;
 
   const std::unique_ptr<VideoCaptureBufferTrackerFactory>
       buffer_tracker_factory_;
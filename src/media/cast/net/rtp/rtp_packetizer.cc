@@ -51,6 +51,7 @@ void RtpPacketizer::SendFrameAsPackets(const EncodedFrame& frame) {
   DCHECK_LE(payload_length, max_length) << "Invalid argument";
 
   SendPacketVector packets;
+  packets.reserve(num_packets);
 
   size_t remaining_size = frame.data.size();
   std::string::const_iterator data_iter = frame.data.begin();
@@ -60,8 +61,15 @@ void RtpPacketizer::SendFrameAsPackets(const EncodedFrame& frame) {
     num_extensions++;
   DCHECK_LE(num_extensions, kCastExtensionCountmask);
 
+  // Extensions are 4 bytes each and only go on the first packet.
+  const size_t max_packet_size =
+      rtp_header_length + num_extensions * 4 + payload_length;
+
   while (remaining_size > 0) {
     PacketRef packet(new base::RefCountedData<Packet>);
+    // Size the packet once up front instead of growing it while the headers
+    // and payload are appended.
+    packet->data.reserve(max_packet_size);
 
     if (remaining_size < payload_length) {
       payload_length = remaining_size;
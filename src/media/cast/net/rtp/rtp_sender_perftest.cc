@@ -0,0 +1,153 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
+#include "base/test/simple_test_tick_clock.h"
+#include "base/time/time.h"
+#include "media/base/fake_single_thread_task_runner.h"
+#include "media/cast/constants.h"
+#include "media/cast/net/pacing/paced_sender.h"
+#include "media/cast/net/rtp/rtp_sender.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+namespace cast {
+
+namespace {
+
+const uint32_t kSsrc = 0x12345;
+
+// Amount of media sent per benchmark run.
+const int kMediaDurationSeconds = 20;
+
+// Number of unacknowledged frames kept in PacketStorage, as if the receiver
+// acknowledged frames a few frame durations after they were sent.
+const int kFramesInFlight = 8;
+
+// Transport that only counts what it is handed, leaving the cost of the
+// packetizer and the pacer.
+class CountingPacketTransport : public PacketTransport {
+ public:
+  CountingPacketTransport() = default;
+
+  bool SendPacket(PacketRef packet, base::OnceClosure cb) final {
+    ++packets_sent_;
+    bytes_sent_ += packet->data.size();
+    return true;
+  }
+
+  int64_t GetBytesSent() final { return bytes_sent_; }
+
+  void StartReceiving(PacketReceiverCallbackWithStatus packet_receiver) final {}
+
+  void StopReceiving() final {}
+
+  int64_t packets_sent() const { return packets_sent_; }
+
+ private:
+  int64_t packets_sent_ = 0;
+  int64_t bytes_sent_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CountingPacketTransport);
+};
+
+}  // namespace
+
+// Measures the per-packet cost of the Cast sender's network path when
+// mirroring: RtpSender packetizes each encoded frame into PacketStorage and
+// PacedSender spreads the packets over bursts. The clock is simulated, so only
+// CPU time is measured.
+class RtpSenderPerfTest : public ::testing::Test {
+ protected:
+  RtpSenderPerfTest()
+      : task_runner_(new FakeSingleThreadTaskRunner(&testing_clock_)),
+        pacer_(kTargetBurstSize,
+               kMaxBurstSize,
+               &testing_clock_,
+               nullptr,
+               &transport_,
+               task_runner_),
+        rtp_sender_(task_runner_, &pacer_) {
+    CastTransportRtpConfig config;
+    config.ssrc = kSsrc;
+    config.rtp_payload_type = RtpPayloadType::VIDEO_VP8;
+    pacer_.RegisterSsrc(kSsrc, false);
+    rtp_sender_.Initialize(config);
+  }
+
+  void RunSendBenchmark(int bitrate_bps, int fps, const std::string& story) {
+    const base::TimeDelta frame_duration =
+        base::TimeDelta::FromSeconds(1) / fps;
+    const int num_frames = kMediaDurationSeconds * fps;
+
+    EncodedFrame frame;
+    frame.dependency = EncodedFrame::DEPENDENT;
+    frame.data.assign(bitrate_bps / 8 / fps, 0x5A);
+
+    const int64_t packets_before = transport_.packets_sent();
+    const int64_t bytes_before = transport_.GetBytesSent();
+    base::TimeDelta send_time;
+    for (int i = 0; i < num_frames; ++i) {
+      frame.frame_id = next_frame_id_++;
+      frame.referenced_frame_id = frame.frame_id - 1;
+      frame.reference_time = testing_clock_.NowTicks();
+      frame.rtp_timestamp = RtpTimeTicks().Expand(
+          static_cast<uint32_t>(i * kVideoFrequency / fps));
+
+      base::TimeTicks start = base::TimeTicks::Now();
+      rtp_sender_.SendFrame(frame);
+      send_time += base::TimeTicks::Now() - start;
+
+      // Drain the pacer over one frame duration, 1 ms at a time.
+      for (base::TimeDelta elapsed; elapsed < frame_duration;
+           elapsed += base::TimeDelta::FromMilliseconds(1)) {
+        testing_clock_.Advance(base::TimeDelta::FromMilliseconds(1));
+        start = base::TimeTicks::Now();
+        task_runner_->RunTasks();
+        send_time += base::TimeTicks::Now() - start;
+      }
+
+      if (frame.frame_id - FrameId::first() >= kFramesInFlight) {
+        rtp_sender_.CancelSendingFrames(
+            std::vector<FrameId>(1, frame.frame_id - kFramesInFlight));
+      }
+    }
+
+    const int64_t packets = transport_.packets_sent() - packets_before;
+    const double megabits =
+        (transport_.GetBytesSent() - bytes_before) * 8 / 1e6;
+    ASSERT_GT(packets, 0);
+
+    perf_test::PerfResultReporter reporter("cast_rtp_sender", story);
+    reporter.RegisterImportantMetric("_packets_per_second", "count");
+    reporter.RegisterImportantMetric("_time_per_megabit", "us");
+    reporter.AddResult("_packets_per_second",
+                       packets / send_time.InSecondsF());
+    reporter.AddResult("_time_per_megabit",
+                       send_time.InMicrosecondsF() / megabits);
+  }
+
+  base::SimpleTestTickClock testing_clock_;
+  scoped_refptr<FakeSingleThreadTaskRunner> task_runner_;
+  CountingPacketTransport transport_;
+  PacedSender pacer_;
+  RtpSender rtp_sender_;
+  FrameId next_frame_id_ = FrameId::first();
+};
+
+TEST_F(RtpSenderPerfTest, SendFrames) {
+  RunSendBenchmark(4 * 1000 * 1000, 30, "mirroring_4mbps_30fps");
+  RunSendBenchmark(10 * 1000 * 1000, 60, "mirroring_10mbps_60fps");
+}
+
+}  // namespace cast
+}  // namespace media
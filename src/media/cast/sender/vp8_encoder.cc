@@ -4,6 +4,9 @@
 
 #include "media/cast/sender/vp8_encoder.h"
 
+#include <algorithm>
+
+#include "base/bits.h"
 #include "base/logging.h"
 #include "media/base/video_frame.h"
 #include "media/cast/constants.h"
@@ -97,12 +100,14 @@ void Vp8Encoder::Initialize() {
 
 void Vp8Encoder::ConfigureForNewFrameSize(const gfx::Size& frame_size) {
   if (is_initialized()) {
-    // Workaround for VP8 bug: If the new size is strictly less-than-or-equal to
-    // the old size, in terms of area, the existing encoder instance can
-    // continue.  Otherwise, completely tear-down and re-create a new encoder to
-    // avoid a shutdown crash.
-    if (frame_size.GetArea() <= gfx::Size(config_.g_w, config_.g_h).GetArea()) {
-      DVLOG(1) << "Continuing to use existing encoder at smaller frame size: "
+    // libvpx lets a VP8 encoder instance continue at any frame size that fits
+    // within the size it was created with, so a capture source that shrinks
+    // and then grows back does not need a new encoder.  Only tear-down and
+    // re-create a new encoder to go beyond that size, to avoid a shutdown
+    // crash.
+    if (frame_size.width() <= encoder_creation_size_.width() &&
+        frame_size.height() <= encoder_creation_size_.height()) {
+      DVLOG(1) << "Reconfiguring existing encoder for new frame size: "
                << gfx::Size(config_.g_w, config_.g_h).ToString() << " --> "
                << frame_size.ToString();
       config_.g_w = frame_size.width();
@@ -110,18 +115,19 @@ void Vp8Encoder::ConfigureForNewFrameSize(const gfx::Size& frame_size) {
       config_.rc_min_quantizer = cast_config_.video_codec_params.min_qp;
       if (vpx_codec_enc_config_set(&encoder_, &config_) == VPX_CODEC_OK)
         return;
-      DVLOG(1) << "libvpx rejected the attempt to use a smaller frame size in "
+      DVLOG(1) << "libvpx rejected the attempt to change the frame size in "
                   "the current instance.";
     }
 
     DVLOG(1) << "Destroying/Re-Creating encoder for larger frame size: "
-             << gfx::Size(config_.g_w, config_.g_h).ToString() << " --> "
+             << encoder_creation_size_.ToString() << " --> "
              << frame_size.ToString();
     vpx_codec_destroy(&encoder_);
   } else {
     DVLOG(1) << "Creating encoder for the first frame; size: "
              << frame_size.ToString();
   }
+  encoder_creation_size_ = frame_size;
 
   // Populate encoder configuration with default values.
   CHECK_EQ(vpx_codec_enc_config_default(vpx_codec_vp8_cx(), &config_, 0),
@@ -181,6 +187,19 @@ void Vp8Encoder::ConfigureForNewFrameSize(const gfx::Size& frame_size) {
   encoding_speed_ = kHighestEncodingSpeed;
   CHECK_EQ(vpx_codec_control(&encoder_, VP8E_SET_CPUUSED, -encoding_speed_),
            VPX_CODEC_OK);
+
+  // With a single token partition, the entropy coding of each frame is done
+  // serially after the macroblock rows have been encoded in parallel.  Split
+  // the bitstream into one partition per encoding thread (up to the VP8 limit
+  // of eight) so that packing the tokens is spread across the threads too.
+  if (config_.g_threads > 1) {
+    const int token_partitions =
+        std::min(static_cast<int>(VP8_EIGHT_TOKENPARTITION),
+                 base::bits::Log2Floor(config_.g_threads));
+    CHECK_EQ(vpx_codec_control(&encoder_, VP8E_SET_TOKEN_PARTITIONS,
+                               token_partitions),
+             VPX_CODEC_OK);
+  }
 }
 
 void Vp8Encoder::Encode(scoped_refptr<media::VideoFrame> video_frame,
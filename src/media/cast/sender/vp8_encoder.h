@@ -46,9 +46,10 @@ class Vp8Encoder : public SoftwareVideoEncoder {
     return config_.g_timebase.den != 0;
   }
 
-  // If the |encoder_| is live, attempt reconfiguration to allow it to encode
-  // frames at a new |frame_size|.  Otherwise, tear it down and re-create a new
-  // |encoder_| instance.
+  // If the |encoder_| is live and |frame_size| fits within the size it was
+  // created with, attempt reconfiguration to allow it to encode frames at the
+  // new |frame_size|.  Otherwise, tear it down and re-create a new |encoder_|
+  // instance.
   void ConfigureForNewFrameSize(const gfx::Size& frame_size);
 
   const FrameSenderConfig cast_config_;
@@ -60,6 +61,10 @@ class Vp8Encoder : public SoftwareVideoEncoder {
   vpx_codec_enc_cfg_t config_;
   vpx_codec_ctx_t encoder_;
 
+  // The frame size |encoder_| was created with.  libvpx accepts
+  // reconfiguration to any size that fits within it.
+  gfx::Size encoder_creation_size_;
+
   // Set to true to request the next frame emitted by Vp8Encoder be a key frame.
   bool key_frame_requested_;
 
@@ -0,0 +1,122 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "media/base/video_frame.h"
+#include "media/cast/cast_config.h"
+#include "media/cast/sender/sender_encoded_frame.h"
+#include "media/cast/sender/vp8_encoder.h"
+#include "media/cast/test/utility/default_config.h"
+#include "media/cast/test/utility/video_utility.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+namespace cast {
+
+namespace {
+
+const int kFrameRate = 30;
+const int kBenchmarkFrames = 150;
+
+// Encodes |kBenchmarkFrames| synthetic frames of |frame_size| with
+// |num_threads| encoding threads and reports the achievable frame rate. The
+// frame content changes every frame, approximating a mirrored screen with a
+// video playing in it.
+void RunEncodeBenchmark(const gfx::Size& frame_size,
+                        int num_threads,
+                        int bitrate_bps) {
+  FrameSenderConfig config = GetDefaultVideoSenderConfig();
+  config.codec = CODEC_VIDEO_VP8;
+  config.use_external_encoder = false;
+  config.max_frame_rate = kFrameRate;
+  config.start_bitrate = bitrate_bps;
+  config.video_codec_params.number_of_encode_threads = num_threads;
+  Vp8Encoder encoder(config);
+  encoder.Initialize();
+
+  base::TimeDelta timestamp;
+  base::TimeDelta encode_time;
+  for (int i = 0; i < kBenchmarkFrames; ++i) {
+    const scoped_refptr<VideoFrame> video_frame = VideoFrame::CreateFrame(
+        PIXEL_FORMAT_I420, frame_size, gfx::Rect(frame_size), frame_size,
+        timestamp);
+    PopulateVideoFrame(video_frame.get(), i);
+    timestamp += base::TimeDelta::FromSeconds(1) / kFrameRate;
+
+    SenderEncodedFrame encoded_frame;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    encoder.Encode(video_frame, base::TimeTicks::UnixEpoch() + timestamp,
+                   &encoded_frame);
+    encode_time += base::TimeTicks::Now() - start;
+    ASSERT_FALSE(encoded_frame.data.empty());
+  }
+
+  perf_test::PerfResultReporter reporter(
+      "cast_vp8_encoder",
+      base::StringPrintf("%dx%d_%d_threads", frame_size.width(),
+                         frame_size.height(), num_threads));
+  reporter.RegisterImportantMetric("_frames_per_second", "fps");
+  reporter.RegisterImportantMetric("_encode_time", "ms");
+  reporter.AddResult("_frames_per_second",
+                     kBenchmarkFrames / encode_time.InSecondsF());
+  reporter.AddResult("_encode_time",
+                     encode_time.InMillisecondsF() / kBenchmarkFrames);
+}
+
+}  // namespace
+
+TEST(Vp8EncoderPerfTest, Encode) {
+  const int kThreadCounts[] = {1, 2, 4};
+  for (int num_threads : kThreadCounts) {
+    RunEncodeBenchmark(gfx::Size(1280, 720), num_threads, 3000000);
+    RunEncodeBenchmark(gfx::Size(1920, 1080), num_threads, 5000000);
+  }
+}
+
+// Measures the cost of a capture source shrinking and growing back, which
+// happens when a mirrored tab or window is resized.
+TEST(Vp8EncoderPerfTest, Resize) {
+  FrameSenderConfig config = GetDefaultVideoSenderConfig();
+  config.codec = CODEC_VIDEO_VP8;
+  config.use_external_encoder = false;
+  config.max_frame_rate = kFrameRate;
+  Vp8Encoder encoder(config);
+  encoder.Initialize();
+
+  const gfx::Size kLargeSize(1920, 1080);
+  const gfx::Size kSmallSize(1280, 720);
+  base::TimeDelta timestamp;
+  base::TimeDelta encode_time;
+  for (int i = 0; i < kBenchmarkFrames; ++i) {
+    const gfx::Size& frame_size = (i % 2) ? kSmallSize : kLargeSize;
+    const scoped_refptr<VideoFrame> video_frame = VideoFrame::CreateFrame(
+        PIXEL_FORMAT_I420, frame_size, gfx::Rect(frame_size), frame_size,
+        timestamp);
+    PopulateVideoFrame(video_frame.get(), i);
+    timestamp += base::TimeDelta::FromSeconds(1) / kFrameRate;
+
+    SenderEncodedFrame encoded_frame;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    encoder.Encode(video_frame, base::TimeTicks::UnixEpoch() + timestamp,
+                   &encoded_frame);
+    encode_time += base::TimeTicks::Now() - start;
+    ASSERT_FALSE(encoded_frame.data.empty());
+  }
+
+  perf_test::PerfResultReporter reporter("cast_vp8_encoder",
+                                         "alternating_1080p_720p");
+  reporter.RegisterImportantMetric("_encode_time", "ms");
+  reporter.AddResult("_encode_time",
+                     encode_time.InMillisecondsF() / kBenchmarkFrames);
+}
+
+}  // namespace cast
+}  // namespace media
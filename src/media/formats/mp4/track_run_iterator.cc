@@ -8,6 +8,7 @@
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <utility>
 
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/checked_math.h"
@@ -65,6 +66,11 @@ struct TrackRunInfo {
 
   TrackRunInfo();
   ~TrackRunInfo();
+
+  // Runs are moved (never copied) into |runs_| and during sorting; |samples|
+  // may hold many thousands of entries for long fragments.
+  TrackRunInfo(TrackRunInfo&&);
+  TrackRunInfo& operator=(TrackRunInfo&&);
 };
 
 TrackRunInfo::TrackRunInfo()
@@ -78,6 +84,8 @@ TrackRunInfo::TrackRunInfo()
       aux_info_total_size(-1) {
 }
 TrackRunInfo::~TrackRunInfo() = default;
+TrackRunInfo::TrackRunInfo(TrackRunInfo&&) = default;
+TrackRunInfo& TrackRunInfo::operator=(TrackRunInfo&&) = default;
 
 base::TimeDelta TimeDeltaFromRational(int64_t numer, int64_t denom) {
   // TODO(sandersd): Change all callers to pass a |denom| as a uint32_t. This is
@@ -282,6 +290,11 @@ class CompareMinTrackRunDataOffset {
 bool TrackRunIterator::Init(const MovieFragment& moof) {
   runs_.clear();
 
+  size_t run_count = 0;
+  for (const TrackFragment& traf : moof.tracks)
+    run_count += traf.runs.size();
+  runs_.reserve(run_count);
+
   for (size_t i = 0; i < moof.tracks.size(); i++) {
     const TrackFragment& traf = moof.tracks[i];
 
@@ -530,7 +543,7 @@ bool TrackRunIterator::Init(const MovieFragment& moof) {
           }
         }
       }
-      runs_.push_back(tri);
+      runs_.push_back(std::move(tri));
       sample_count_sum += trun.sample_count;
     }
 
@@ -474,17 +474,18 @@ bool WebMClusterParser::OnBlock(bool is_simple_block,
 
   Track* track = NULL;
   StreamParserBuffer::Type buffer_type = DemuxerStream::AUDIO;
-  std::string encryption_key_id;
+  // Points at the track's key ID rather than copying it for every block.
+  const std::string* encryption_key_id = nullptr;
   base::TimeDelta encoded_duration = kNoTimestamp;
   if (track_num == audio_.track_num()) {
     track = &audio_;
-    encryption_key_id = audio_encryption_key_id_;
-    if (encryption_key_id.empty()) {
+    encryption_key_id = &audio_encryption_key_id_;
+    if (encryption_key_id->empty()) {
       encoded_duration = TryGetEncodedAudioDuration(data, size);
     }
   } else if (track_num == video_.track_num()) {
     track = &video_;
-    encryption_key_id = video_encryption_key_id_;
+    encryption_key_id = &video_encryption_key_id_;
     buffer_type = DemuxerStream::VIDEO;
   } else if (ignored_tracks_.find(track_num) != ignored_tracks_.end()) {
     return true;
@@ -524,11 +525,11 @@ bool WebMClusterParser::OnBlock(bool is_simple_block,
     // See: http://www.webmproject.org/docs/webm-encryption/
     std::unique_ptr<DecryptConfig> decrypt_config;
     int data_offset = 0;
-    if (!encryption_key_id.empty() &&
+    if (!encryption_key_id->empty() &&
         !WebMCreateDecryptConfig(
              data, size,
-             reinterpret_cast<const uint8_t*>(encryption_key_id.data()),
-             encryption_key_id.size(),
+             reinterpret_cast<const uint8_t*>(encryption_key_id->data()),
+             encryption_key_id->size(),
              &decrypt_config, &data_offset)) {
       MEDIA_LOG(ERROR, media_log_) << "Failed to extract decrypt config.";
       return false;
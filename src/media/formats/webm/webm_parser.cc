@@ -17,6 +17,7 @@
 #include <iomanip>
 #include <limits>
 
+#include "base/bits.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/stl_util.h"
@@ -453,34 +454,26 @@ static int ParseWebMElementHeaderField(const uint8_t* buf,
   if (size == 0)
     return 0;
 
-  int mask = 0x80;
-  uint8_t ch = buf[0];
-  int extra_bytes = -1;
-  bool all_ones = false;
-  for (int i = 0; i < max_bytes; ++i) {
-    if ((ch & mask) != 0) {
-      mask = ~mask & 0xff;
-      *num = mask_first_byte ? ch & mask : ch;
-      all_ones = (ch & mask) == mask;
-      extra_bytes = i;
-      break;
-    }
-    mask = 0x80 | mask >> 1;
-  }
-
-  if (extra_bytes == -1)
+  // The number of leading zero bits in the first byte is the number of bytes
+  // that follow it, so the field length is known without scanning bit by bit.
+  const uint8_t ch = buf[0];
+  const int extra_bytes = base::bits::CountLeadingZeroBits(ch);
+  if (extra_bytes >= max_bytes)
     return -1;
 
   // Return 0 if we need more data.
   if ((1 + extra_bytes) > size)
     return 0;
 
-  int bytes_used = 1;
+  const uint8_t mask = 0x7f >> extra_bytes;
+  *num = mask_first_byte ? ch & mask : ch;
+  bool all_ones = (ch & mask) == mask;
 
+  int bytes_used = 1;
   for (int i = 0; i < extra_bytes; ++i) {
-    ch = buf[bytes_used++];
-    all_ones &= (ch == 0xff);
-    *num = (*num << 8) | ch;
+    const uint8_t next = buf[bytes_used++];
+    all_ones &= (next == 0xff);
+    *num = (*num << 8) | next;
   }
 
   if (all_ones)
@@ -38,13 +38,14 @@ void MediaPlatformAPI::BufferQueue::Pop() {
   queue_.pop();
 }
 
-bool MediaPlatformAPI::BufferQueue::Empty() {
+bool MediaPlatformAPI::BufferQueue::Empty() const {
   return queue_.empty();
 }
 
 void MediaPlatformAPI::BufferQueue::Clear() {
   DecoderBufferQueue empty_queue;
   queue_.swap(empty_queue);
+  data_size_ = 0;
 }
 
 size_t MediaPlatformAPI::BufferQueue::DataSize() const {
@@ -120,7 +120,7 @@ class MEDIA_EXPORT MediaPlatformAPI
     void Pop();
     void Clear();
 
-    bool Empty();
+    bool Empty() const;
     size_t DataSize() const;
 
    private:
@@ -16,13 +16,30 @@
 
 #include "media/neva/media_platform_api_mock.h"
 
+#include <initializer_list>
+
+#include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/single_thread_task_runner.h"
+#include "base/time/default_tick_clock.h"
 
 namespace media {
 
-MediaPlatformAPIMock::MediaPlatformAPIMock(const base::Closure& resume_done_cb,
-                                           const base::Closure& suspend_done_cb)
-    : resume_done_cb_(resume_done_cb), suspend_done_cb_(suspend_done_cb) {}
+constexpr base::TimeDelta MediaPlatformAPIMock::kDecodeAheadTime;
+constexpr base::TimeDelta MediaPlatformAPIMock::kEnoughDataTime;
+constexpr base::TimeDelta MediaPlatformAPIMock::kSeekLatency;
+constexpr size_t MediaPlatformAPIMock::kMaxVideoBufferedBytes;
+constexpr size_t MediaPlatformAPIMock::kMaxAudioBufferedBytes;
+
+MediaPlatformAPIMock::MediaPlatformAPIMock(
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
+    const base::Closure& resume_done_cb,
+    const base::Closure& suspend_done_cb)
+    : task_runner_(task_runner),
+      resume_done_cb_(resume_done_cb),
+      suspend_done_cb_(suspend_done_cb),
+      tick_clock_(base::DefaultTickClock::GetInstance()),
+      clock_base_ticks_(tick_clock_->NowTicks()) {}
 
 MediaPlatformAPIMock::~MediaPlatformAPIMock() {}
 
@@ -36,8 +53,8 @@ scoped_refptr<MediaPlatformAPI> MediaPlatformAPI::Create(
     const base::Closure& suspend_done_cb,
     const ActiveRegionCB& active_region_cb,
     const PipelineStatusCB& error_cb) {
-  return base::MakeRefCounted<MediaPlatformAPIMock>(resume_done_cb,
-                                                    suspend_done_cb);
+  return base::MakeRefCounted<MediaPlatformAPIMock>(
+      task_runner, resume_done_cb, suspend_done_cb);
 }
 
 bool MediaPlatformAPI::IsAvailable() {
@@ -56,10 +73,45 @@ void MediaPlatformAPIMock::SetDisplayWindow(const gfx::Rect& rect,
 
 bool MediaPlatformAPIMock::Feed(const scoped_refptr<DecoderBuffer>& buffer,
                                 FeedType type) {
+  StreamState& stream = GetStreamState(type);
+  ConsumeBuffers(&stream);
+
+  if (buffer->end_of_stream()) {
+    stream.eos_received = true;
+    return true;
+  }
+
+  stream.queue.Push(buffer, type);
+  stream.last_timestamp = buffer->timestamp();
+
+  if (!buffer_full_ && !AllowedFeed(type, type == FeedType::kVideo
+                                              ? kMaxVideoBufferedBytes
+                                              : kMaxAudioBufferedBytes)) {
+    buffer_full_ = true;
+    if (!player_event_cb_.is_null())
+      player_event_cb_.Run(PlayerEvent::kBufferFull);
+  }
   return true;
 }
 
-void MediaPlatformAPIMock::Seek(base::TimeDelta time) {}
+void MediaPlatformAPIMock::Seek(base::TimeDelta time) {
+  video_.queue.Clear();
+  video_.eos_received = false;
+  audio_.queue.Clear();
+  audio_.eos_received = false;
+  buffer_full_ = false;
+
+  {
+    base::AutoLock auto_lock(clock_lock_);
+    clock_base_time_ = time;
+    clock_base_ticks_ = tick_clock_->NowTicks();
+  }
+
+  seeking_ = true;
+  task_runner_->PostDelayedTask(
+      FROM_HERE, base::BindOnce(&MediaPlatformAPIMock::OnSeekDone, this),
+      kSeekLatency);
+}
 
 void MediaPlatformAPIMock::Suspend(SuspendReason reason) {
   if (!suspend_done_cb_.is_null())
@@ -72,24 +124,33 @@ void MediaPlatformAPIMock::Resume(base::TimeDelta paused_time,
     resume_done_cb_.Run();
 }
 
-void MediaPlatformAPIMock::SetPlaybackRate(float playback_rate) {}
+void MediaPlatformAPIMock::SetPlaybackRate(float playback_rate) {
+  base::AutoLock auto_lock(clock_lock_);
+  const base::TimeTicks now = tick_clock_->NowTicks();
+  clock_base_time_ += (now - clock_base_ticks_) * playback_rate_;
+  clock_base_ticks_ = now;
+  playback_rate_ = playback_rate;
+}
 
 void MediaPlatformAPIMock::SetPlaybackVolume(double volume) {}
 
 bool MediaPlatformAPIMock::AllowedFeedVideo() {
-  return true;
+  return AllowedFeed(FeedType::kVideo, kMaxVideoBufferedBytes);
 }
 
 bool MediaPlatformAPIMock::AllowedFeedAudio() {
-  return true;
+  return AllowedFeed(FeedType::kAudio, kMaxAudioBufferedBytes);
 }
 
-void MediaPlatformAPIMock::Finalize() {}
+void MediaPlatformAPIMock::Finalize() {
+  video_.queue.Clear();
+  audio_.queue.Clear();
+}
 
 void MediaPlatformAPIMock::SetKeySystem(const std::string& key_system) {}
 
 bool MediaPlatformAPIMock::IsEOSReceived() {
-  return false;
+  return video_.eos_received || audio_.eos_received;
 }
 
 void MediaPlatformAPIMock::UpdateVideoConfig(
@@ -102,7 +163,79 @@ void MediaPlatformAPIMock::SwitchToAutoLayout() {}
 void MediaPlatformAPIMock::SetDisableAudio(bool disable) {}
 
 bool MediaPlatformAPIMock::HaveEnoughData() {
+  if (seeking_)
+    return false;
+
+  for (StreamState* stream : {&video_, &audio_}) {
+    ConsumeBuffers(stream);
+    if (!stream->eos_received && GetBufferedTime(*stream) < kEnoughDataTime)
+      return false;
+  }
+  return true;
+}
+
+base::TimeDelta MediaPlatformAPIMock::GetCurrentTime() {
+  return GetMediaTime();
+}
+
+void MediaPlatformAPIMock::SetPlayerEventCb(const PlayerEventCB& cb) {
+  player_event_cb_ = cb;
+}
+
+void MediaPlatformAPIMock::SetTickClockForTesting(
+    const base::TickClock* tick_clock) {
+  base::AutoLock auto_lock(clock_lock_);
+  tick_clock_ = tick_clock;
+  clock_base_ticks_ = tick_clock_->NowTicks();
+}
+
+MediaPlatformAPIMock::StreamState& MediaPlatformAPIMock::GetStreamState(
+    FeedType type) {
+  return type == FeedType::kVideo ? video_ : audio_;
+}
+
+base::TimeDelta MediaPlatformAPIMock::GetMediaTime() const {
+  base::AutoLock auto_lock(clock_lock_);
+  return clock_base_time_ +
+         (tick_clock_->NowTicks() - clock_base_ticks_) * playback_rate_;
+}
+
+void MediaPlatformAPIMock::ConsumeBuffers(StreamState* stream) {
+  // Nothing is decoded until the seek completes, as on the real platform.
+  if (seeking_)
+    return;
+
+  const base::TimeDelta decode_until = GetMediaTime() + kDecodeAheadTime;
+  while (!stream->queue.Empty() &&
+         stream->queue.Front().first->timestamp() <= decode_until) {
+    stream->queue.Pop();
+  }
+}
+
+base::TimeDelta MediaPlatformAPIMock::GetBufferedTime(
+    const StreamState& stream) const {
+  if (stream.queue.Empty())
+    return base::TimeDelta();
+  return stream.last_timestamp - GetMediaTime();
+}
+
+bool MediaPlatformAPIMock::AllowedFeed(FeedType type,
+                                       size_t max_buffered_bytes) {
+  StreamState& stream = GetStreamState(type);
+  ConsumeBuffers(&stream);
+  if (stream.queue.DataSize() >= max_buffered_bytes)
+    return false;
+
+  // Re-arm the kBufferFull notification once the decoder has drained below
+  // the limit.
+  buffer_full_ = false;
   return true;
 }
 
+void MediaPlatformAPIMock::OnSeekDone() {
+  seeking_ = false;
+  if (!player_event_cb_.is_null())
+    player_event_cb_.Run(PlayerEvent::kSeekDone);
+}
+
 }  // namespace media
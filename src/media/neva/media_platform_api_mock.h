@@ -17,14 +17,44 @@
 #ifndef MEDIA_NEVA_MEDIA_PLATFORM_API_MOCK_H_
 #define MEDIA_NEVA_MEDIA_PLATFORM_API_MOCK_H_
 
+#include "base/memory/scoped_refptr.h"
+#include "base/time/time.h"
 #include "media/neva/media_platform_api.h"
 
+namespace base {
+class TickClock;
+}
+
 namespace media {
 
+// Hardware-free MediaPlatformAPI used with use_neva_media_for_testing. It
+// models a platform pipeline closely enough to exercise and measure the feed
+// path on a plain Linux host: fed buffers are queued per stream and consumed
+// once the media clock comes within |kDecodeAheadTime| of their timestamp,
+// feeding is refused when a stream's queue is over its byte limit, and seeks
+// complete asynchronously after |kSeekLatency|.
 class MEDIA_EXPORT MediaPlatformAPIMock : public MediaPlatformAPI {
  public:
-  MediaPlatformAPIMock(const base::Closure& resume_done_cb,
-                       const base::Closure& suspend_done_cb);
+  // How far ahead of the media clock the simulated decoder consumes buffers.
+  static constexpr base::TimeDelta kDecodeAheadTime =
+      base::TimeDelta::FromMilliseconds(100);
+
+  // Buffered duration above which HaveEnoughData() returns true.
+  static constexpr base::TimeDelta kEnoughDataTime =
+      base::TimeDelta::FromSeconds(2);
+
+  // Time between Seek() and the PlayerEvent::kSeekDone notification.
+  static constexpr base::TimeDelta kSeekLatency =
+      base::TimeDelta::FromMilliseconds(30);
+
+  // Per-stream queue limits above which AllowedFeed*() return false.
+  static constexpr size_t kMaxVideoBufferedBytes = 16 * 1024 * 1024;
+  static constexpr size_t kMaxAudioBufferedBytes = 1 * 1024 * 1024;
+
+  MediaPlatformAPIMock(
+      const scoped_refptr<base::SingleThreadTaskRunner>& task_runner,
+      const base::Closure& resume_done_cb,
+      const base::Closure& suspend_done_cb);
 
   void Initialize(const AudioDecoderConfig& audio_config,
                   const VideoDecoderConfig& video_config,
@@ -53,13 +83,55 @@ class MEDIA_EXPORT MediaPlatformAPIMock : public MediaPlatformAPI {
   void SetDisableAudio(bool disable) override;
 
   bool HaveEnoughData() override;
+  base::TimeDelta GetCurrentTime() override;
+  void SetPlayerEventCb(const PlayerEventCB& cb) override;
+
+  void SetTickClockForTesting(const base::TickClock* tick_clock);
 
  private:
   ~MediaPlatformAPIMock() override;
   friend class base::RefCountedThreadSafe<MediaPlatformAPIMock>;
 
+  struct StreamState {
+    BufferQueue queue;
+    base::TimeDelta last_timestamp;
+    bool eos_received = false;
+  };
+
+  StreamState& GetStreamState(FeedType type);
+
+  // Returns the media time according to |tick_clock_| and the playback rate.
+  base::TimeDelta GetMediaTime() const;
+
+  // Drops buffers the simulated decoder has consumed by now from |stream|.
+  void ConsumeBuffers(StreamState* stream);
+
+  // Returns how far ahead of the media clock |stream| is buffered.
+  base::TimeDelta GetBufferedTime(const StreamState& stream) const;
+
+  bool AllowedFeed(FeedType type, size_t max_buffered_bytes);
+  void OnSeekDone();
+
+  const scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   base::Closure resume_done_cb_;
   base::Closure suspend_done_cb_;
+  PlayerEventCB player_event_cb_;
+
+  const base::TickClock* tick_clock_;
+
+  StreamState video_;
+  StreamState audio_;
+
+  // Media time at |clock_base_ticks_|; the clock advances from there at
+  // |playback_rate_|. GetCurrentTime() may be called from any thread, so these
+  // are guarded by |clock_lock_|. Everything else is used on |task_runner_|.
+  mutable base::Lock clock_lock_;
+  base::TimeDelta clock_base_time_;
+  base::TimeTicks clock_base_ticks_;
+  float playback_rate_ = 0.0f;
+
+  bool seeking_ = false;
+  bool buffer_full_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(MediaPlatformAPIMock);
 };
@@ -0,0 +1,192 @@
+// Copyright 2020 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/time/time_override.h"
+#include "media/base/decoder_buffer.h"
+#include "media/neva/media_platform_api_mock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+
+namespace {
+
+// Amount of media fed per benchmark run.
+constexpr base::TimeDelta kMediaDuration = base::TimeDelta::FromMinutes(10);
+
+constexpr base::TimeDelta kAudioFrameDuration =
+    base::TimeDelta::FromMicroseconds(21333);
+constexpr size_t kAudioFrameSize = 768;
+
+constexpr int kSeekIterations = 100;
+
+}  // namespace
+
+// Drives MediaPlatformAPIMock the way the neva MSE renderer feeds a platform
+// pipeline: as much as AllowedFeed*() permits, then waits for playback to make
+// room. Media time is mocked, so only the CPU spent on the feed path is
+// measured. MOCK_TIME also overrides base::TimeTicks::Now(), so wall time is
+// read with base::subtle::TimeTicksNowIgnoringOverride().
+class MediaPlatformAPIPerfTest : public testing::Test {
+ public:
+  MediaPlatformAPIPerfTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME) {}
+
+  void SetUp() override {
+    api_ = MediaPlatformAPI::Create(
+        task_environment_.GetMainThreadTaskRunner(), true, std::string(),
+        MediaPlatformAPI::NaturalVideoSizeChangedCB(), base::Closure(),
+        base::Closure(), MediaPlatformAPI::ActiveRegionCB(),
+        PipelineStatusCB());
+    static_cast<MediaPlatformAPIMock*>(api_.get())
+        ->SetTickClockForTesting(task_environment_.GetMockTickClock());
+    api_->SetPlayerEventCb(base::BindRepeating(
+        &MediaPlatformAPIPerfTest::OnPlayerEvent, base::Unretained(this)));
+  }
+
+  void TearDown() override { api_->Finalize(); }
+
+ protected:
+  // Feeds |kMediaDuration| of |video_bitrate_bps| video at |fps| interleaved
+  // with AAC sized audio frames and reports the feed cost. The per-buffer time
+  // includes creating the DecoderBuffer, as the renderer does before Feed().
+  void RunFeedBenchmark(int video_bitrate_bps,
+                        int fps,
+                        const std::string& story) {
+    const base::TimeDelta video_frame_duration =
+        base::TimeDelta::FromSeconds(1) / fps;
+    std::vector<uint8_t> video_data(video_bitrate_bps / 8 / fps, 0xAB);
+    std::vector<uint8_t> audio_data(kAudioFrameSize, 0xCD);
+
+    // Start from an empty pipeline at time zero.
+    api_->SetPlaybackRate(0.0f);
+    api_->Seek(base::TimeDelta());
+    task_environment_.FastForwardBy(MediaPlatformAPIMock::kSeekLatency);
+    api_->SetPlaybackRate(1.0f);
+
+    base::TimeDelta video_timestamp;
+    base::TimeDelta audio_timestamp;
+    int64_t fed_bytes = 0;
+    int feed_count = 0;
+    base::TimeDelta feed_time;
+    const base::ThreadTicks cpu_start = base::ThreadTicks::IsSupported()
+                                            ? base::ThreadTicks::Now()
+                                            : base::ThreadTicks();
+    while (video_timestamp < kMediaDuration) {
+      const base::TimeTicks start =
+          base::subtle::TimeTicksNowIgnoringOverride();
+      while (video_timestamp < kMediaDuration && api_->AllowedFeedVideo()) {
+        scoped_refptr<DecoderBuffer> buffer =
+            DecoderBuffer::CopyFrom(video_data.data(), video_data.size());
+        buffer->set_timestamp(video_timestamp);
+        ASSERT_TRUE(api_->Feed(buffer, FeedType::kVideo));
+        fed_bytes += video_data.size();
+        ++feed_count;
+        video_timestamp += video_frame_duration;
+
+        while (audio_timestamp < video_timestamp && api_->AllowedFeedAudio()) {
+          buffer =
+              DecoderBuffer::CopyFrom(audio_data.data(), audio_data.size());
+          buffer->set_timestamp(audio_timestamp);
+          ASSERT_TRUE(api_->Feed(buffer, FeedType::kAudio));
+          fed_bytes += audio_data.size();
+          ++feed_count;
+          audio_timestamp += kAudioFrameDuration;
+        }
+      }
+      feed_time += base::subtle::TimeTicksNowIgnoringOverride() - start;
+
+      // Let the simulated platform play out one video frame's worth of media.
+      task_environment_.FastForwardBy(video_frame_duration);
+    }
+
+    perf_test::PerfResultReporter reporter("neva_media_platform_api", story);
+    reporter.RegisterImportantMetric("_feed_throughput", "MB/s");
+    reporter.RegisterImportantMetric("_feed_time", "us");
+    reporter.AddResult("_feed_throughput",
+                       fed_bytes / (1024.0 * 1024.0) / feed_time.InSecondsF());
+    reporter.AddResult("_feed_time", feed_time.InMicrosecondsF() / feed_count);
+    if (base::ThreadTicks::IsSupported()) {
+      reporter.RegisterImportantMetric("_cpu_per_media_second", "us");
+      reporter.AddResult(
+          "_cpu_per_media_second",
+          (base::ThreadTicks::Now() - cpu_start).InMicrosecondsF() /
+              kMediaDuration.InSecondsF());
+    }
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  scoped_refptr<MediaPlatformAPI> api_;
+  int seek_done_count_ = 0;
+
+ private:
+  void OnPlayerEvent(PlayerEvent event) {
+    if (event == PlayerEvent::kSeekDone)
+      ++seek_done_count_;
+  }
+};
+
+TEST_F(MediaPlatformAPIPerfTest, Feed) {
+  RunFeedBenchmark(4 * 1000 * 1000, 30, "1080p30_4mbps");
+  RunFeedBenchmark(20 * 1000 * 1000, 60, "2160p60_20mbps");
+}
+
+// Measures the cost of Seek() when both streams' queues are full.
+TEST_F(MediaPlatformAPIPerfTest, Seek) {
+  const base::TimeDelta kVideoFrameDuration =
+      base::TimeDelta::FromSeconds(1) / 30;
+  std::vector<uint8_t> video_data(16 * 1024, 0xAB);
+  std::vector<uint8_t> audio_data(kAudioFrameSize, 0xCD);
+
+  base::TimeDelta seek_time;
+  for (int i = 0; i < kSeekIterations; ++i) {
+    const base::TimeDelta seek_target = base::TimeDelta::FromSeconds(i * 10);
+    for (base::TimeDelta ts = seek_target; api_->AllowedFeedVideo();
+         ts += kVideoFrameDuration) {
+      scoped_refptr<DecoderBuffer> buffer =
+          DecoderBuffer::CopyFrom(video_data.data(), video_data.size());
+      buffer->set_timestamp(ts);
+      api_->Feed(buffer, FeedType::kVideo);
+    }
+    for (base::TimeDelta ts = seek_target; api_->AllowedFeedAudio();
+         ts += kAudioFrameDuration) {
+      scoped_refptr<DecoderBuffer> buffer =
+          DecoderBuffer::CopyFrom(audio_data.data(), audio_data.size());
+      buffer->set_timestamp(ts);
+      api_->Feed(buffer, FeedType::kAudio);
+    }
+
+    const base::TimeTicks start = base::subtle::TimeTicksNowIgnoringOverride();
+    api_->Seek(seek_target + base::TimeDelta::FromSeconds(5));
+    seek_time += base::subtle::TimeTicksNowIgnoringOverride() - start;
+    task_environment_.FastForwardBy(MediaPlatformAPIMock::kSeekLatency);
+  }
+  EXPECT_EQ(kSeekIterations, seek_done_count_);
+
+  perf_test::PerfResultReporter reporter("neva_media_platform_api",
+                                         "seek_full_queues");
+  reporter.RegisterImportantMetric("_seek_time", "us");
+  reporter.AddResult("_seek_time",
+                     seek_time.InMicrosecondsF() / kSeekIterations);
+}
+
+}  // namespace media
@@ -286,8 +286,10 @@ void DemuxerStreamAdapter::OnNewBuffer(DemuxerStream::Status status,
       DCHECK(pending_frame_.empty());
       if (!data_pipe_writer_.IsPipeValid())
         return;  // Do not start sending (due to previous fatal error).
-      pending_frame_ = DecoderBufferToByteArray(*input);
+      pending_frame_ = DecoderBufferHeaderToByteArray(*input);
       pending_frame_is_eos_ = input->end_of_stream();
+      if (!pending_frame_is_eos_)
+        pending_frame_data_ = std::move(input);
       WriteFrame();
     } break;
   }
@@ -304,8 +306,24 @@ void DemuxerStreamAdapter::WriteFrame() {
     return;
   }
 
-  stream_sender_->SendFrame(pending_frame_.size());
-  data_pipe_writer_.Write(pending_frame_.data(), pending_frame_.size(),
+  const uint32_t frame_data_size =
+      pending_frame_data_ ? pending_frame_data_->data_size() : 0;
+  stream_sender_->SendFrame(pending_frame_.size() + frame_data_size);
+  data_pipe_writer_.Write(
+      pending_frame_.data(), pending_frame_.size(),
+      base::BindOnce(&DemuxerStreamAdapter::OnFrameHeaderWritten,
+                     base::Unretained(this)));
+}
+
+void DemuxerStreamAdapter::OnFrameHeaderWritten(bool success) {
+  if (!success || !pending_frame_data_ ||
+      pending_frame_data_->data_size() == 0) {
+    OnFrameWritten(success);
+    return;
+  }
+
+  data_pipe_writer_.Write(pending_frame_data_->data(),
+                          pending_frame_data_->data_size(),
                           base::BindOnce(&DemuxerStreamAdapter::OnFrameWritten,
                                          base::Unretained(this)));
 }
@@ -317,6 +335,8 @@ void DemuxerStreamAdapter::OnFrameWritten(bool success) {
   }
 
   bytes_written_to_pipe_ += pending_frame_.size();
+  if (pending_frame_data_)
+    bytes_written_to_pipe_ += pending_frame_data_->data_size();
   // Resets frame buffer variables.
   bool pending_frame_is_eos = pending_frame_is_eos_;
   ++last_count_;
@@ -387,6 +407,7 @@ void DemuxerStreamAdapter::SendReadAck() {
 void DemuxerStreamAdapter::ResetPendingFrame() {
   DCHECK(media_task_runner_->BelongsToCurrentThread());
   pending_frame_.clear();
+  pending_frame_data_.reset();
   pending_frame_is_eos_ = false;
 }
 
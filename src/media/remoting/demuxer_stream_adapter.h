@@ -116,9 +116,12 @@ class DemuxerStreamAdapter {
   // Callback function when retrieving data from demuxer.
   void OnNewBuffer(DemuxerStream::Status status,
                    scoped_refptr<DecoderBuffer> input);
-  // Write the current frame into the mojo data pipe. OnFrameWritten() will be
-  // called when the writing has finished.
+  // Write the current frame into the mojo data pipe. The serialized header is
+  // written first and the frame data is then written straight from
+  // |pending_frame_data_|. OnFrameWritten() will be called when the writing has
+  // finished.
   void WriteFrame();
+  void OnFrameHeaderWritten(bool success);
   void OnFrameWritten(bool success);
   void ResetPendingFrame();
 
@@ -172,9 +175,11 @@ class DemuxerStreamAdapter {
   // aborted and data should be discarded when the value is true.
   bool pending_flush_;
 
-  // Frame buffer and its information that is currently in process of writing to
-  // Mojo data pipe.
+  // Frame header, frame data and information about the frame that is currently
+  // in process of writing to Mojo data pipe. |pending_frame_data_| is null for
+  // end of stream buffers.
   std::vector<uint8_t> pending_frame_;
+  scoped_refptr<DecoderBuffer> pending_frame_data_;
   bool pending_frame_is_eos_;
 
   // Keeps latest demuxer stream status and audio/video decoder config.
@@ -201,7 +201,7 @@ scoped_refptr<DecoderBuffer> ByteArrayToDecoderBuffer(const uint8_t* data,
   return nullptr;
 }
 
-std::vector<uint8_t> DecoderBufferToByteArray(
+std::vector<uint8_t> DecoderBufferHeaderToByteArray(
     const DecoderBuffer& decoder_buffer) {
   pb::DecoderBuffer decoder_buffer_message;
   ConvertDecoderBufferToProto(decoder_buffer, &decoder_buffer_message);
@@ -209,8 +209,7 @@ std::vector<uint8_t> DecoderBufferToByteArray(
   size_t decoder_buffer_size =
       decoder_buffer.end_of_stream() ? 0 : decoder_buffer.data_size();
   size_t size = kPayloadVersionFieldSize + kProtoBufferHeaderSize +
-                decoder_buffer_message.ByteSize() + kDataBufferHeaderSize +
-                decoder_buffer_size;
+                decoder_buffer_message.ByteSize() + kDataBufferHeaderSize;
   std::vector<uint8_t> buffer(size);
   base::BigEndianWriter writer(reinterpret_cast<char*>(buffer.data()),
                                buffer.size());
@@ -221,11 +220,6 @@ std::vector<uint8_t> DecoderBufferToByteArray(
           writer.ptr(), decoder_buffer_message.GetCachedSize()) &&
       writer.Skip(decoder_buffer_message.GetCachedSize()) &&
       writer.WriteU32(decoder_buffer_size)) {
-    if (decoder_buffer_size) {
-      // DecoderBuffer frame data.
-      writer.WriteBytes(reinterpret_cast<const void*>(decoder_buffer.data()),
-                        decoder_buffer.data_size());
-    }
     return buffer;
   }
 
@@ -235,6 +229,17 @@ std::vector<uint8_t> DecoderBufferToByteArray(
   return buffer;
 }
 
+std::vector<uint8_t> DecoderBufferToByteArray(
+    const DecoderBuffer& decoder_buffer) {
+  std::vector<uint8_t> buffer = DecoderBufferHeaderToByteArray(decoder_buffer);
+  if (!buffer.empty() && !decoder_buffer.end_of_stream()) {
+    // DecoderBuffer frame data.
+    buffer.insert(buffer.end(), decoder_buffer.data(),
+                  decoder_buffer.data() + decoder_buffer.data_size());
+  }
+  return buffer;
+}
+
 void ConvertEncryptionSchemeToProto(EncryptionScheme encryption_scheme,
                                     pb::EncryptionScheme* message) {
   DCHECK(message);
@@ -57,6 +57,13 @@ class CdmPromiseResult;
 std::vector<uint8_t> DecoderBufferToByteArray(
     const DecoderBuffer& decoder_buffer);
 
+// Converts DecoderBufferSegment into byte array, leaving out the trailing
+// |data_buffer|. Writing |decoder_buffer.data()| right after the returned bytes
+// produces the same stream as DecoderBufferToByteArray() without copying the
+// frame data.
+std::vector<uint8_t> DecoderBufferHeaderToByteArray(
+    const DecoderBuffer& decoder_buffer);
+
 // Converts byte array into DecoderBufferSegment.
 scoped_refptr<DecoderBuffer> ByteArrayToDecoderBuffer(const uint8_t* data,
                                                       uint32_t size);
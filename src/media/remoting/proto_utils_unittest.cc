@@ -112,6 +112,23 @@ TEST_F(ProtoUtilsTest, PassValidDecoderBuffer) {
   }
 }
 
+TEST_F(ProtoUtilsTest, DecoderBufferHeaderFollowedByData) {
+  const uint8_t buffer[] = {0, 0, 0, 1, 9, 224, 0, 0, 0, 1, 103, 77};
+  scoped_refptr<DecoderBuffer> input_buffer =
+      DecoderBuffer::CopyFrom(buffer, sizeof(buffer));
+  input_buffer->set_timestamp(base::TimeDelta::FromMilliseconds(33));
+  input_buffer->set_is_key_frame(true);
+
+  std::vector<uint8_t> data = DecoderBufferHeaderToByteArray(*input_buffer);
+  data.insert(data.end(), input_buffer->data(),
+              input_buffer->data() + input_buffer->data_size());
+  ASSERT_EQ(DecoderBufferToByteArray(*input_buffer), data);
+
+  scoped_refptr<DecoderBuffer> eos_buffer = DecoderBuffer::CreateEOSBuffer();
+  ASSERT_EQ(DecoderBufferToByteArray(*eos_buffer),
+            DecoderBufferHeaderToByteArray(*eos_buffer));
+}
+
 TEST_F(ProtoUtilsTest, AudioDecoderConfigConversionTest) {
   const std::string extra_data = "ACEG";
   const EncryptionScheme encryption_scheme = EncryptionScheme::kCenc;
@@ -22,7 +22,6 @@
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "cc/base/math_util.h"
-#include "cc/paint/skia_paint_canvas.h"
 #include "components/viz/client/client_resource_provider.h"
 #include "components/viz/client/shared_bitmap_reporter.h"
 #include "components/viz/common/gpu/context_provider.h"
@@ -48,7 +47,6 @@
 #include "third_party/libyuv/include/libyuv.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "ui/gfx/geometry/size_conversions.h"
-#include "ui/gfx/skia_util.h"
 #include "ui/gl/gl_enums.h"
 #include "ui/gl/trace_util.h"
 
@@ -978,23 +976,18 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     if (!plane_resource->Matches(video_frame->unique_id(), 0)) {
       // We need to transfer data from |video_frame| to the plane resource.
       if (software_compositor()) {
-        if (!video_renderer_)
-          video_renderer_ = std::make_unique<PaintCanvasVideoRenderer>();
-
         SoftwarePlaneResource* software_resource = plane_resource->AsSoftware();
 
-        // We know the format is RGBA_8888 from check above.
-        SkImageInfo info = SkImageInfo::MakeN32Premul(
-            gfx::SizeToSkISize(software_resource->resource_size()));
-
-        SkBitmap sk_bitmap;
-        sk_bitmap.installPixels(info, software_resource->pixels(),
-                                info.minRowBytes());
-        cc::SkiaPaintCanvas canvas(sk_bitmap);
-
-        // This is software path, so canvas and video_frame are always backed
-        // by software.
-        video_renderer_->Copy(video_frame, &canvas, nullptr);
+        // Convert directly into the shared bitmap. Painting the frame through
+        // PaintCanvasVideoRenderer would first rasterize it into a cached
+        // SkImage and then copy that, doubling the memory traffic per frame.
+        // ConvertVideoFrameToRGBPixels() writes N32 premultiplied pixels,
+        // which is the format of software compositor resources.
+        size_t bytes_per_row = viz::ResourceSizes::CheckedWidthInBytes<size_t>(
+            software_resource->resource_size().width(),
+            viz::ResourceFormat::RGBA_8888);
+        PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+            video_frame.get(), software_resource->pixels(), bytes_per_row);
       } else {
         HardwarePlaneResource* hardware_resource = plane_resource->AsHardware();
         size_t bytes_per_row = viz::ResourceSizes::CheckedWidthInBytes<size_t>(
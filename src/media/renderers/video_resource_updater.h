@@ -41,7 +41,6 @@ class SharedBitmapReporter;
 }  // namespace viz
 
 namespace media {
-class PaintCanvasVideoRenderer;
 class VideoFrame;
 
 // Specifies what type of data is contained in the mailboxes, as well as how
@@ -203,7 +202,6 @@ class MEDIA_EXPORT VideoResourceUpdater
   const bool use_r16_texture_;
   const int max_resource_size_;
   const int tracing_id_;
-  std::unique_ptr<PaintCanvasVideoRenderer> video_renderer_;
   uint32_t next_plane_resource_id_ = 1;
 
   // Temporary pixel buffer when converting between formats.
@@ -0,0 +1,140 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "media/base/decoder_buffer.h"
+#include "media/base/media_tracks.h"
+#include "media/base/media_util.h"
+#include "media/base/stream_parser.h"
+#include "media/base/test_data_util.h"
+#include "media/formats/webm/webm_stream_parser.h"
+#include "media/media_buildflags.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+#if BUILDFLAG(USE_PROPRIETARY_CODECS)
+#include "media/formats/mp4/es_descriptor.h"
+#include "media/formats/mp4/mp4_stream_parser.h"
+#endif
+
+namespace media {
+
+namespace {
+
+// Number of times the test file is appended back to back, approximating a
+// long VOD asset made of many media segments.
+const int kAppendRepetitions = 200;
+
+// Size of each Parse() call, roughly what a network read delivers to MSE.
+const size_t kAppendSize = 64 * 1024;
+
+}  // namespace
+
+// Measures StreamParser overhead independent of demuxing and decoding:
+// time-to-first-buffers after the first append and overall parse throughput.
+class StreamParserPerfTest : public testing::Test {
+ public:
+  StreamParserPerfTest() = default;
+
+ protected:
+  void RunParseBenchmark(std::unique_ptr<StreamParser> parser,
+                         const std::string& filename,
+                         const std::string& story) {
+    parser_ = std::move(parser);
+    parser_->Init(
+        base::BindOnce(&StreamParserPerfTest::OnInit, base::Unretained(this)),
+        base::BindRepeating(&StreamParserPerfTest::OnNewConfig,
+                            base::Unretained(this)),
+        base::BindRepeating(&StreamParserPerfTest::OnNewBuffers,
+                            base::Unretained(this)),
+        true,
+        base::BindRepeating(&StreamParserPerfTest::OnEncryptedMediaInitData,
+                            base::Unretained(this)),
+        base::BindRepeating(&StreamParserPerfTest::OnNewSegment,
+                            base::Unretained(this)),
+        base::BindRepeating(&StreamParserPerfTest::OnEndOfSegment,
+                            base::Unretained(this)),
+        &media_log_);
+
+    scoped_refptr<DecoderBuffer> file = ReadTestDataFile(filename);
+
+    start_ = base::TimeTicks::Now();
+    for (int i = 0; i < kAppendRepetitions; ++i) {
+      for (size_t offset = 0; offset < file->data_size();
+           offset += kAppendSize) {
+        const size_t size = std::min(kAppendSize, file->data_size() - offset);
+        ASSERT_TRUE(parser_->Parse(file->data() + offset, size));
+      }
+    }
+    const base::TimeDelta total_time = base::TimeTicks::Now() - start_;
+    ASSERT_FALSE(time_to_first_buffers_.is_zero());
+
+    const double total_megabytes =
+        static_cast<double>(file->data_size()) * kAppendRepetitions /
+        (1024 * 1024);
+    perf_test::PerfResultReporter reporter("stream_parser", story);
+    reporter.RegisterImportantMetric("_time_to_first_buffers", "us");
+    reporter.RegisterImportantMetric("_throughput", "MB/s");
+    reporter.RegisterImportantMetric("_buffers", "count");
+    reporter.AddResult("_time_to_first_buffers",
+                       time_to_first_buffers_.InMicrosecondsF());
+    reporter.AddResult("_throughput",
+                       total_megabytes / total_time.InSecondsF());
+    reporter.AddResult("_buffers", static_cast<size_t>(buffer_count_));
+  }
+
+ private:
+  void OnInit(const StreamParser::InitParameters& params) {}
+
+  bool OnNewConfig(std::unique_ptr<MediaTracks> tracks,
+                   const StreamParser::TextTrackConfigMap& text_configs) {
+    return true;
+  }
+
+  bool OnNewBuffers(const StreamParser::BufferQueueMap& buffer_queue_map) {
+    if (time_to_first_buffers_.is_zero())
+      time_to_first_buffers_ = base::TimeTicks::Now() - start_;
+    for (const auto& it : buffer_queue_map)
+      buffer_count_ += it.second.size();
+    return true;
+  }
+
+  void OnEncryptedMediaInitData(EmeInitDataType type,
+                                const std::vector<uint8_t>& init_data) {}
+  void OnNewSegment() {}
+  void OnEndOfSegment() {}
+
+  NullMediaLog media_log_;
+  std::unique_ptr<StreamParser> parser_;
+  base::TimeTicks start_;
+  base::TimeDelta time_to_first_buffers_;
+  int64_t buffer_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(StreamParserPerfTest);
+};
+
+TEST_F(StreamParserPerfTest, WebM) {
+  RunParseBenchmark(std::make_unique<WebMStreamParser>(),
+                    "bear-320x240.webm", "webm_320x240");
+}
+
+#if BUILDFLAG(USE_PROPRIETARY_CODECS)
+TEST_F(StreamParserPerfTest, MP4) {
+  std::set<int> audio_object_types;
+  audio_object_types.insert(mp4::kISO_14496_3);
+  RunParseBenchmark(std::make_unique<mp4::MP4StreamParser>(
+                        audio_object_types, false, false),
+                    "bear-1280x720-av_frag.mp4", "mp4_av_frag");
+}
+#endif
+
+}  // namespace media
@@ -0,0 +1,113 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "media/base/media_util.h"
+#include "media/base/stream_parser.h"
+#include "media/base/timestamp_constants.h"
+#include "media/formats/webm/cluster_builder.h"
+#include "media/formats/webm/webm_cluster_parser.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace media {
+
+namespace {
+
+const int kTimecodeScale = 1000000;  // 1 ms per timecode unit.
+const int kAudioTrackNum = 1;
+const int kVideoTrackNum = 2;
+
+// Each cluster holds one second of 60 fps video and 20 ms audio frames.
+const int kClusterDurationMs = 1000;
+const int kVideoFrameIntervalMs = 16;
+const int kAudioFrameIntervalMs = 20;
+const int kAudioFrameSize = 640;
+
+// Number of times the cluster is parsed per benchmark run.
+const int kClusterRepetitions = 500;
+
+std::unique_ptr<Cluster> BuildCluster(int video_frame_size,
+                                      bool use_block_groups) {
+  std::vector<uint8_t> video_frame(video_frame_size, 0xAB);
+  std::vector<uint8_t> audio_frame(kAudioFrameSize, 0xCD);
+
+  ClusterBuilder cb;
+  cb.SetClusterTimecode(0);
+  int audio_timecode = 0;
+  for (int video_timecode = 0; video_timecode < kClusterDurationMs;
+       video_timecode += kVideoFrameIntervalMs) {
+    for (; audio_timecode <= video_timecode;
+         audio_timecode += kAudioFrameIntervalMs) {
+      cb.AddSimpleBlock(kAudioTrackNum, audio_timecode, 0x80,
+                        audio_frame.data(), audio_frame.size());
+    }
+    const bool is_key_frame = video_timecode == 0;
+    if (use_block_groups) {
+      cb.AddBlockGroup(kVideoTrackNum, video_timecode, kVideoFrameIntervalMs,
+                       0, is_key_frame, video_frame.data(),
+                       video_frame.size());
+    } else {
+      cb.AddSimpleBlock(kVideoTrackNum, video_timecode,
+                        is_key_frame ? 0x80 : 0, video_frame.data(),
+                        video_frame.size());
+    }
+  }
+  return cb.Finish();
+}
+
+// Measures WebMClusterParser throughput on synthetic clusters whose video
+// frame sizes approximate low and high bitrate VP9 streams.
+void RunClusterParseBenchmark(int video_frame_size, bool use_block_groups) {
+  std::unique_ptr<Cluster> cluster =
+      BuildCluster(video_frame_size, use_block_groups);
+
+  NullMediaLog media_log;
+  WebMClusterParser parser(
+      kTimecodeScale, kAudioTrackNum, kNoTimestamp, kVideoTrackNum,
+      kNoTimestamp, WebMTracksParser::TextTracks(), std::set<int64_t>(),
+      std::string(), std::string(), kUnknownAudioCodec, &media_log);
+
+  int64_t buffer_count = 0;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kClusterRepetitions; ++i) {
+    ASSERT_EQ(cluster->size(), parser.Parse(cluster->data(), cluster->size()));
+    StreamParser::BufferQueueMap buffers;
+    parser.GetBuffers(&buffers);
+    for (const auto& it : buffers)
+      buffer_count += it.second.size();
+  }
+  const double total_time_seconds =
+      (base::TimeTicks::Now() - start).InSecondsF();
+
+  perf_test::PerfResultReporter reporter(
+      "webm_cluster_parser",
+      base::StringPrintf("%s_%d", use_block_groups ? "block_group" : "simple",
+                         video_frame_size));
+  reporter.RegisterImportantMetric("_throughput", "MB/s");
+  reporter.RegisterImportantMetric("_blocks_per_second", "count");
+  reporter.AddResult("_throughput", static_cast<double>(cluster->size()) *
+                                        kClusterRepetitions /
+                                        (1024 * 1024) / total_time_seconds);
+  reporter.AddResult("_blocks_per_second", buffer_count / total_time_seconds);
+}
+
+}  // namespace
+
+TEST(WebMClusterParserPerfTest, Parse) {
+  // Roughly 1, 8 and 25 Mbps of 60 fps video.
+  const int kVideoFrameSizes[] = {2 * 1024, 16 * 1024, 52 * 1024};
+  for (int video_frame_size : kVideoFrameSizes) {
+    RunClusterParseBenchmark(video_frame_size, false);
+    RunClusterParseBenchmark(video_frame_size, true);
+  }
+}
+
+}  // namespace media
@@ -71,6 +71,9 @@ InputSyncWriter::InputSyncWriter(
   DVLOG(1) << "audio bus memory size: " << audio_bus_memory_size_;
 
   audio_buses_.resize(shared_memory_segment_count);
+  // The renderer never has more read verifications outstanding than there
+  // are segments.
+  read_indices_.reserve(shared_memory_segment_count);
 
   // Create vector of audio buses by wrapping existing blocks of memory.
   uint8_t* ptr = static_cast<uint8_t*>(shared_memory_mapping_.memory());
@@ -123,8 +126,9 @@ InputSyncWriter::~InputSyncWriter() {
                             AUDIO_CAPTURER_AUDIO_GLITCHES_MAX + 1);
 
   std::string log_string = base::StringPrintf(
-      "AISW: number of detected audio glitches: %" PRIuS " out of %" PRIuS,
-      write_error_count_, write_count_);
+      "AISW: number of detected audio glitches: %" PRIuS " out of %" PRIuS
+      ", max fifo size: %" PRIuS,
+      write_error_count_, write_count_, max_overflow_data_size_);
   log_callback_.Run(log_string);
 }
 
@@ -180,13 +184,15 @@ void InputSyncWriter::Write(const media::AudioBus* data,
   // writing. We verify that each buffer index is in sequence.
   size_t number_of_indices_available = socket_->Peek() / sizeof(uint32_t);
   if (number_of_indices_available > 0) {
-    auto indices = std::make_unique<uint32_t[]>(number_of_indices_available);
+    read_indices_.resize(number_of_indices_available);
     size_t bytes_received = socket_->Receive(
-        &indices[0], number_of_indices_available * sizeof(indices[0]));
-    CHECK_EQ(number_of_indices_available * sizeof(indices[0]), bytes_received);
+        read_indices_.data(),
+        number_of_indices_available * sizeof(read_indices_[0]));
+    CHECK_EQ(number_of_indices_available * sizeof(read_indices_[0]),
+             bytes_received);
     for (size_t i = 0; i < number_of_indices_available; ++i) {
       ++next_read_buffer_index_;
-      CHECK_EQ(indices[i], next_read_buffer_index_);
+      CHECK_EQ(read_indices_[i], next_read_buffer_index_);
       CHECK_GT(number_of_filled_segments_, 0u);
       --number_of_filled_segments_;
     }
@@ -290,13 +296,24 @@ bool InputSyncWriter::PushDataToFifo(const media::AudioBus* data,
     log_callback_.Run(message);
   }
 
-  // Push data to fifo.
-  std::unique_ptr<media::AudioBus> audio_bus =
-      media::AudioBus::Create(data->channels(), data->frames());
+  // Push data to fifo, reusing a bus from an earlier overflow if possible
+  // since the fifo tends to fill and drain repeatedly while the renderer is
+  // starved.
+  std::unique_ptr<media::AudioBus> audio_bus;
+  if (!free_overflow_buses_.empty() &&
+      free_overflow_buses_.back()->channels() == data->channels() &&
+      free_overflow_buses_.back()->frames() == data->frames()) {
+    audio_bus = std::move(free_overflow_buses_.back());
+    free_overflow_buses_.pop_back();
+  } else {
+    audio_bus = media::AudioBus::Create(data->channels(), data->frames());
+  }
   data->CopyTo(audio_bus.get());
   overflow_data_.emplace_back(volume, key_pressed, capture_time,
                               std::move(audio_bus));
   DCHECK_LE(overflow_data_.size(), static_cast<size_t>(kMaxOverflowBusesSize));
+  max_overflow_data_size_ =
+      std::max(max_overflow_data_size_, overflow_data_.size());
 
   return true;
 }
@@ -323,6 +340,7 @@ bool InputSyncWriter::WriteDataFromFifoToSharedMemory() {
     if (!SignalDataWrittenAndUpdateCounters())
       write_error = true;
 
+    free_overflow_buses_.push_back(std::move(data_it->audio_bus_));
     ++data_it;
   }
 
@@ -185,6 +185,17 @@ class InputSyncWriter final : public InputController::SyncWriter {
 
   std::vector<OverflowData> overflow_data_;
 
+  // Buses of fifo entries that have been written to shared memory, kept for
+  // reuse by PushDataToFifo().
+  std::vector<std::unique_ptr<media::AudioBus>> free_overflow_buses_;
+
+  // The largest number of entries |overflow_data_| has held. Reported with
+  // the glitch summary as a measure of how far the renderer fell behind.
+  size_t max_overflow_data_size_ = 0;
+
+  // Scratch space for the read verifications received in Write().
+  std::vector<uint32_t> read_indices_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(InputSyncWriter);
 };
 
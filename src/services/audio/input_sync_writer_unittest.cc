@@ -151,6 +151,10 @@ class InputSyncWriterTest : public testing::Test {
            number_of_buffers_in_fifo == writer_->overflow_data_.size();
   }
 
+  size_t NumberOfFreeOverflowBuses() const {
+    return writer_->free_overflow_buses_.size();
+  }
+
  protected:
   using MockLogger =
       base::MockCallback<base::RepeatingCallback<void(const std::string&)>>;
@@ -330,4 +334,31 @@ TEST_F(InputSyncWriterTest, MultipleFillAndEmptyRingBufferAndPartOfFifo) {
   EXPECT_TRUE(TestSocketAndFifoExpectations(0, 3 * sizeof(uint32_t), 0));
 }
 
+TEST_F(InputSyncWriterTest, FifoReusesBusesAfterDraining) {
+  EXPECT_CALL(mock_logger_, Run(_)).Times(GetTotalNumberOfExpectedLogCalls(3));
+
+  // Fill the ring buffer and put two blocks in the fifo. Should render one log
+  // call for starting filling it.
+  for (int i = 1; i <= kSegments + 2; ++i) {
+    writer_->Write(audio_bus_.get(), 0, false, base::TimeTicks::Now());
+  }
+  EXPECT_TRUE(TestSocketAndFifoExpectations(kSegments, 0, 2));
+  EXPECT_EQ(0u, NumberOfFreeOverflowBuses());
+
+  // Empty the ring buffer. The next write drains the fifo, rendering a log
+  // call for emptying it, and keeps its buses for reuse.
+  socket_->Read(kSegments);
+  writer_->Write(audio_bus_.get(), 0, false, base::TimeTicks::Now());
+  EXPECT_TRUE(TestSocketAndFifoExpectations(3, 0, 0));
+  EXPECT_EQ(2u, NumberOfFreeOverflowBuses());
+
+  // Overflow into the fifo again. Should render one log call for starting
+  // filling it, and take the buses kept above.
+  for (int i = 1; i <= kSegments - 3 + 2; ++i) {
+    writer_->Write(audio_bus_.get(), 0, false, base::TimeTicks::Now());
+  }
+  EXPECT_TRUE(TestSocketAndFifoExpectations(kSegments, 0, 2));
+  EXPECT_EQ(0u, NumberOfFreeOverflowBuses());
+}
+
 }  // namespace audio
@@ -22,6 +22,7 @@
 #include "base/threading/platform_thread.h"
 #include "base/trace_event/trace_event.h"
 #include "media/base/audio_timestamp_helper.h"
+#include "services/audio/output_device_mixer.h"
 #include "services/audio/stream_monitor.h"
 
 using base::TimeDelta;
@@ -143,7 +144,8 @@ OutputController::OutputController(media::AudioManager* audio_manager,
                                    EventHandler* handler,
                                    const media::AudioParameters& params,
                                    const std::string& output_device_id,
-                                   SyncReader* sync_reader)
+                                   SyncReader* sync_reader,
+                                   OutputDeviceMixer* output_mixer)
     : audio_manager_(audio_manager),
       params_(params),
       handler_(handler),
@@ -155,6 +157,7 @@ OutputController::OutputController(media::AudioManager* audio_manager,
       volume_(1.0),
       state_(kEmpty),
       sync_reader_(sync_reader),
+      output_mixer_(output_mixer),
       power_monitor_(
           params.sample_rate(),
           TimeDelta::FromMilliseconds(kPowerMeasurementTimeConstantMillis)) {
@@ -162,6 +165,11 @@ OutputController::OutputController(media::AudioManager* audio_manager,
   DCHECK(handler_);
   DCHECK(sync_reader_);
   DCHECK(task_runner_.get());
+  // Registered for the controller's whole lifetime rather than while it holds
+  // a mixable stream: a muted or failed controller still goes back to the
+  // mixer on StopMuting() or RecreateStream().
+  if (output_mixer_)
+    output_mixer_->AddUser();
 }
 
 OutputController::~OutputController() {
@@ -169,6 +177,8 @@ OutputController::~OutputController() {
   DCHECK_EQ(kClosed, state_);
   DCHECK_EQ(nullptr, stream_);
   DCHECK(snoopers_.empty());
+  if (output_mixer_)
+    output_mixer_->RemoveUser();
   UMA_HISTOGRAM_LONG_TIMES("Media.AudioOutputController.LifeTime",
                            base::TimeTicks::Now() - construction_time_);
 }
@@ -215,6 +225,7 @@ void OutputController::RecreateStream(OutputController::RecreateReason reason) {
 
   StopCloseAndClearStream();  // Calls RemoveOutputDeviceChangeListener().
   DCHECK_EQ(kEmpty, state_);
+  stream_is_mixed_ = false;
 
   if (disable_local_output_) {
     SendLogMessage("%s => (WARNING: using a fake audio output stream)",
@@ -228,6 +239,9 @@ void OutputController::RecreateStream(OutputController::RecreateReason reason) {
     stream_ = audio_manager_->MakeAudioOutputStream(
         mute_params, std::string(),
         /*log_callback, not used*/ base::DoNothing());
+  } else if (output_mixer_) {
+    stream_ = output_mixer_->MakeMixableStream();
+    stream_is_mixed_ = true;
   } else {
     stream_ =
         audio_manager_->MakeAudioOutputStreamProxy(params_, output_device_id_);
@@ -286,7 +300,9 @@ void OutputController::RecreateStream(OutputController::RecreateReason reason) {
       break;  // Not counted in UMAs.
   }
 
-  audio_manager_->AddOutputDeviceChangeListener(this);
+  // The mixer moves its streams to the new device itself on a device change.
+  if (!stream_is_mixed_)
+    audio_manager_->AddOutputDeviceChangeListener(this);
 
   // We have successfully opened the stream. Set the initial volume.
   stream_->SetVolume(volume_);
@@ -60,6 +60,8 @@
 
 namespace audio {
 
+class OutputDeviceMixer;
+
 class OutputController : public media::AudioOutputStream::AudioSourceCallback,
                          public LoopbackGroupMember,
                          public media::AudioManager::AudioDeviceListener {
@@ -114,12 +116,15 @@ class OutputController : public media::AudioOutputStream::AudioSourceCallback,
 
   // |audio_manager| and |handler| must outlive OutputController.  The
   // |output_device_id| can be either empty (default device) or specify a
-  // specific hardware device for audio output.
+  // specific hardware device for audio output.  If |output_mixer| is not null,
+  // it must outlive OutputController, which then plays through a stream mixed
+  // by it rather than through a stream of its own.
   OutputController(media::AudioManager* audio_manager,
                    EventHandler* handler,
                    const media::AudioParameters& params,
                    const std::string& output_device_id,
-                   SyncReader* sync_reader);
+                   SyncReader* sync_reader,
+                   OutputDeviceMixer* output_mixer);
   ~OutputController() override;
 
   // Indicates whether audio power level analysis will be performed.  If false,
@@ -296,6 +301,13 @@ class OutputController : public media::AudioOutputStream::AudioSourceCallback,
   // SyncReader is used only in low latency mode for synchronous reading.
   SyncReader* const sync_reader_;
 
+  // Mixes the audio of this stream with other streams to the same device, if
+  // not null.
+  OutputDeviceMixer* const output_mixer_;
+
+  // True if |stream_| was made by |output_mixer_|.
+  bool stream_is_mixed_ = false;
+
   // Scans audio samples from OnMoreData() as input to compute power levels.
   media::AudioPowerMonitor power_monitor_;
 
@@ -35,6 +35,7 @@
 #include "media/base/audio_bus.h"
 #include "media/base/audio_parameters.h"
 #include "services/audio/loopback_group_member.h"
+#include "services/audio/output_device_mixer.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -321,15 +322,36 @@ class OutputControllerTest : public ::testing::Test {
 
   ~OutputControllerTest() override { audio_manager_.Shutdown(); }
 
-  void SetUp() override {
+  void SetUp() override { CreateController(/*use_mixer=*/false); }
+
+  void TearDown() override { controller_ = base::nullopt; }
+
+ protected:
+  // Creates the controller under test, playing through mixer() if
+  // |use_mixer|.
+  void CreateController(bool use_mixer) {
+    if (use_mixer) {
+      mixer_ = std::make_unique<OutputDeviceMixer>(
+          &audio_manager_, std::string(), GetTestParams());
+    }
     controller_.emplace(&audio_manager_, &mock_event_handler_, GetTestParams(),
-                        std::string(), &mock_sync_reader_);
+                        std::string(), &mock_sync_reader_, mixer_.get());
     controller_->SetVolume(kTestVolume);
   }
 
-  void TearDown() override { controller_ = base::nullopt; }
+  OutputDeviceMixer* mixer() const { return mixer_.get(); }
+
+  // Creates, opens, closes and destroys another controller playing through
+  // mixer(), as another stream to the same device would.
+  void CreateAndDestroyOtherMixedController() {
+    NiceMock<MockOutputControllerEventHandler> event_handler;
+    NiceMock<MockOutputControllerSyncReader> sync_reader;
+    OutputController other(&audio_manager_, &event_handler, GetTestParams(),
+                           std::string(), &sync_reader, mixer_.get());
+    EXPECT_TRUE(other.CreateStream());
+    other.Close();
+  }
 
- protected:
   // Returns the last-created or last-closed AudioOuptutStream.
   MockAudioOutputStream* last_created_stream() const {
     return audio_manager_.last_created_stream();
@@ -474,6 +496,8 @@ class OutputControllerTest : public ::testing::Test {
   AudioManagerForControllerTest audio_manager_;
   base::UnguessableToken group_id_;
   StrictMock<MockOutputControllerSyncReader> mock_sync_reader_;
+  // Declared before |controller_|, which must not outlive it.
+  std::unique_ptr<OutputDeviceMixer> mixer_;
   base::Optional<OutputController> controller_;
 
   DISALLOW_COPY_AND_ASSIGN(OutputControllerTest);
@@ -598,6 +622,42 @@ TEST_F(OutputControllerTest, PlayMuteUnmuteClose) {
   EXPECT_EQ(playout_stream, last_closed_stream());
 }
 
+class OutputControllerMixerTest : public OutputControllerTest {
+ public:
+  void SetUp() override { CreateController(/*use_mixer=*/true); }
+};
+
+// A muted controller holds no mixable stream, but goes back to its mixer when
+// unmuted, so it must keep the mixer in use while another stream to the same
+// device comes and goes.
+TEST_F(OutputControllerMixerTest, MuteDestroyOtherStreamUnmute) {
+  StartMutingBeforePlaying();
+  Create();
+  Play();
+  MockAudioOutputStream* const mute_stream = last_created_stream();
+  ASSERT_TRUE(mute_stream);
+  EXPECT_EQ(AudioParameters::AUDIO_FAKE, mute_stream->format());
+  EXPECT_FALSE(mixer()->HasStreams());
+
+  CreateAndDestroyOtherMixedController();
+  EXPECT_FALSE(mixer()->HasStreams());
+  EXPECT_TRUE(mixer()->HasUsers());
+
+  // Unmuting plays through the mixer's device stream.
+  StopMuting();
+  MockAudioOutputStream* const device_stream = last_created_stream();
+  ASSERT_TRUE(device_stream);
+  EXPECT_NE(mute_stream, device_stream);
+  EXPECT_EQ(GetTestParams().format(), device_stream->format());
+  EXPECT_TRUE(mixer()->HasStreams());
+
+  Close();
+  EXPECT_EQ(device_stream, last_closed_stream());
+  EXPECT_FALSE(mixer()->HasStreams());
+  TearDown();
+  EXPECT_FALSE(mixer()->HasUsers());
+}
+
 TEST_F(OutputControllerTest, SnoopCreatePlayStopClose) {
   NiceMock<MockSnooper> snooper;
   StartSnooping(&snooper);
@@ -0,0 +1,278 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/audio/output_device_mixer.h"
+
+#include "base/trace_event/trace_event.h"
+#include "media/base/audio_bus.h"
+#include "media/base/vector_math.h"
+
+namespace audio {
+
+// An AudioOutputStream whose source is pulled by the mixer instead of by a
+// device. Owned by itself; deleted by Close().
+class OutputDeviceMixer::MixableStream final : public media::AudioOutputStream {
+ public:
+  explicit MixableStream(OutputDeviceMixer* mixer) : mixer_(mixer) {}
+  ~MixableStream() final = default;
+
+  // AudioOutputStream implementation.
+  bool Open() final {
+    DCHECK(!opened_);
+    opened_ = mixer_->OpenStream();
+    return opened_;
+  }
+
+  void Start(AudioSourceCallback* callback) final {
+    DCHECK(opened_);
+    DCHECK(callback);
+    if (callback_)
+      return;
+    callback_ = callback;
+    mixer_->StartStream(this);
+  }
+
+  void Stop() final {
+    if (!callback_)
+      return;
+    mixer_->StopStream(this);
+    callback_ = nullptr;
+  }
+
+  void SetVolume(double volume) final {
+    base::AutoLock lock(mixer_->lock_);
+    volume_ = volume;
+  }
+
+  void GetVolume(double* volume) final {
+    base::AutoLock lock(mixer_->lock_);
+    *volume = volume_;
+  }
+
+  void Close() final {
+    Stop();
+    mixer_->CloseStream(opened_);
+    delete this;
+  }
+
+  void Flush() final {}
+
+  // Called under the mixer's lock while the stream is playing.
+  double volume() const {
+    mixer_->lock_.AssertAcquired();
+    return volume_;
+  }
+
+  // Called on the device thread by the mixer's OnMoreData(), under the mixer's
+  // render lock, while the stream is playing or being stopped. All streams
+  // share the device's parameters, so the delay of the device is the delay of
+  // this stream.
+  void Render(base::TimeDelta delay,
+              base::TimeTicks delay_timestamp,
+              int prior_frames_skipped,
+              media::AudioBus* dest) {
+    mixer_->render_lock_.AssertAcquired();
+    callback_->OnMoreData(delay, delay_timestamp, prior_frames_skipped, dest);
+  }
+
+  // Called under the mixer's lock while the stream is playing.
+  void ReportError(ErrorType type) {
+    mixer_->lock_.AssertAcquired();
+    callback_->OnError(type);
+  }
+
+ private:
+  OutputDeviceMixer* const mixer_;
+  bool opened_ = false;
+
+  // Non-null while playing. Set on the audio manager thread before the stream
+  // is added to the mixer, and reset after it is removed and any render of it
+  // has finished.
+  AudioSourceCallback* callback_ = nullptr;
+
+  // Accessed under the mixer's lock.
+  double volume_ = 1.0;
+
+  DISALLOW_COPY_AND_ASSIGN(MixableStream);
+};
+
+OutputDeviceMixer::OutputDeviceMixer(media::AudioManager* audio_manager,
+                                     const std::string& device_id,
+                                     const media::AudioParameters& params)
+    : audio_manager_(audio_manager),
+      device_id_(device_id),
+      params_(params),
+      stream_bus_(media::AudioBus::Create(params)) {
+  DCHECK(audio_manager_);
+  DCHECK(params_.IsValid());
+  DCHECK(!params_.IsBitstreamFormat());
+}
+
+OutputDeviceMixer::~OutputDeviceMixer() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_EQ(0, user_count_);
+  DCHECK_EQ(0, stream_count_);
+  DCHECK(!device_stream_);
+}
+
+void OutputDeviceMixer::AddUser() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  ++user_count_;
+}
+
+void OutputDeviceMixer::RemoveUser() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_GT(user_count_, 0);
+  --user_count_;
+}
+
+bool OutputDeviceMixer::HasUsers() const {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  return user_count_ > 0;
+}
+
+bool OutputDeviceMixer::HasStreams() const {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  return stream_count_ > 0;
+}
+
+media::AudioOutputStream* OutputDeviceMixer::MakeMixableStream() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  ++stream_count_;
+  return new MixableStream(this);
+}
+
+int OutputDeviceMixer::OnMoreData(base::TimeDelta delay,
+                                  base::TimeTicks delay_timestamp,
+                                  int prior_frames_skipped,
+                                  media::AudioBus* dest) {
+  TRACE_EVENT1("audio", "OutputDeviceMixer::OnMoreData", "delay (ms)",
+               delay.InMillisecondsF());
+  base::AutoLock render_lock(render_lock_);
+  {
+    base::AutoLock lock(lock_);
+    render_streams_.clear();
+    for (MixableStream* stream : playing_streams_)
+      render_streams_.emplace_back(stream, stream->volume());
+  }
+
+  // The sources wait for their renderers, so call them without holding
+  // |lock_|. media::AudioConverter is not used: its inputs can't change while
+  // it converts, which would hold every control call behind the render. With
+  // no resampling or channel mixing to do, it would only apply the same
+  // FMAC() per input as this loop.
+  dest->Zero();
+  for (const auto& stream_and_volume : render_streams_) {
+    stream_bus_->Zero();
+    stream_and_volume.first->Render(delay, delay_timestamp,
+                                    prior_frames_skipped, stream_bus_.get());
+    const float volume = static_cast<float>(stream_and_volume.second);
+    for (int ch = 0; ch < dest->channels(); ++ch) {
+      media::vector_math::FMAC(stream_bus_->channel(ch), volume, dest->frames(),
+                               dest->channel(ch));
+    }
+  }
+  return dest->frames();
+}
+
+void OutputDeviceMixer::OnError(ErrorType type) {
+  TRACE_EVENT0("audio", "OutputDeviceMixer::OnError");
+  // The device change listener, registered while |device_stream_| is open,
+  // moves the physical stream to the new device. Handling the error as well
+  // would re-create it a second time. The mixable streams keep playing, so
+  // their sources are not told about the device change.
+  if (type == ErrorType::kDeviceChange)
+    return;
+  base::AutoLock lock(lock_);
+  for (MixableStream* stream : playing_streams_)
+    stream->ReportError(type);
+}
+
+void OutputDeviceMixer::OnDeviceChange() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  TRACE_EVENT0("audio", "OutputDeviceMixer::OnDeviceChange");
+  if (!device_stream_)
+    return;
+
+  // Move the mixed streams over to a stream on the new device.
+  CloseDeviceStream();
+  if (!OpenDeviceStream()) {
+    base::AutoLock lock(lock_);
+    for (MixableStream* stream : playing_streams_)
+      stream->ReportError(ErrorType::kUnknown);
+    return;
+  }
+  if (playing_stream_count_ > 0)
+    device_stream_->Start(this);
+}
+
+bool OutputDeviceMixer::OpenStream() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (!device_stream_ && !OpenDeviceStream())
+    return false;
+  ++open_stream_count_;
+  return true;
+}
+
+void OutputDeviceMixer::StartStream(MixableStream* stream) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  {
+    base::AutoLock lock(lock_);
+    playing_streams_.insert(stream);
+  }
+  // Device calls are made without holding |lock_|, which OnMoreData() takes.
+  if (++playing_stream_count_ == 1 && device_stream_)
+    device_stream_->Start(this);
+}
+
+void OutputDeviceMixer::StopStream(MixableStream* stream) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_GT(playing_stream_count_, 0);
+  if (--playing_stream_count_ == 0 && device_stream_)
+    device_stream_->Stop();
+  {
+    base::AutoLock lock(lock_);
+    playing_streams_.erase(stream);
+  }
+  // A render may have picked up |stream| before it was removed. Wait for it to
+  // finish, as the stream's source must not be called after Stop() returns.
+  base::AutoLock wait_for_render(render_lock_);
+}
+
+void OutputDeviceMixer::CloseStream(bool was_opened) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_GT(stream_count_, 0);
+  --stream_count_;
+  if (!was_opened)
+    return;
+  DCHECK_GT(open_stream_count_, 0);
+  if (--open_stream_count_ == 0 && device_stream_)
+    CloseDeviceStream();
+}
+
+bool OutputDeviceMixer::OpenDeviceStream() {
+  DCHECK(!device_stream_);
+  device_stream_ = audio_manager_->MakeAudioOutputStreamProxy(params_,
+                                                               device_id_);
+  if (!device_stream_)
+    return false;
+  if (!device_stream_->Open()) {
+    device_stream_->Close();
+    device_stream_ = nullptr;
+    return false;
+  }
+  audio_manager_->AddOutputDeviceChangeListener(this);
+  return true;
+}
+
+void OutputDeviceMixer::CloseDeviceStream() {
+  DCHECK(device_stream_);
+  audio_manager_->RemoveOutputDeviceChangeListener(this);
+  if (playing_stream_count_ > 0)
+    device_stream_->Stop();
+  device_stream_->Close();
+  device_stream_ = nullptr;
+}
+
+}  // namespace audio
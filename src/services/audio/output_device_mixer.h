@@ -0,0 +1,141 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_AUDIO_OUTPUT_DEVICE_MIXER_H_
+#define SERVICES_AUDIO_OUTPUT_DEVICE_MIXER_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/containers/flat_set.h"
+#include "base/macros.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_checker.h"
+#include "base/time/time.h"
+#include "media/audio/audio_io.h"
+#include "media/audio/audio_manager.h"
+#include "media/base/audio_parameters.h"
+
+namespace media {
+class AudioBus;
+}  // namespace media
+
+namespace audio {
+
+// Mixes all the streams created through MakeMixableStream() into a single
+// physical output stream for |device_id|. This avoids opening one platform
+// stream per renderer stream, which is costly, and on some platforms (e.g.,
+// ALSA without a sound server) limited.
+//
+// Every mixable stream shares the mixer's AudioParameters, so mixing only
+// applies the per-stream volume and sums the streams; no latency is added.
+//
+// The physical stream is opened when the first mixable stream is opened and
+// closed along with the last one; it plays as long as any mixable stream is
+// playing. The mixer re-creates the physical stream once per device change,
+// when its AudioDeviceListener is notified, and is the only one to do so:
+// kDeviceChange errors are ignored, and the sources of mixable streams are not
+// told about device changes.
+//
+// All methods, and those of the mixable streams, must be called on the audio
+// manager thread, except for the AudioSourceCallback methods, which are called
+// on the device thread.
+class OutputDeviceMixer final
+    : public media::AudioOutputStream::AudioSourceCallback,
+      public media::AudioManager::AudioDeviceListener {
+ public:
+  // |audio_manager| must outlive the mixer.
+  OutputDeviceMixer(media::AudioManager* audio_manager,
+                    const std::string& device_id,
+                    const media::AudioParameters& params);
+  ~OutputDeviceMixer() final;
+
+  const std::string& device_id() const { return device_id_; }
+  const media::AudioParameters& params() const { return params_; }
+
+  // Users, such as OutputControllers, register for as long as they may call
+  // MakeMixableStream(), including while they hold no mixable stream, e.g.
+  // while muted. The owner must keep the mixer alive while HasUsers().
+  void AddUser();
+  void RemoveUser();
+  bool HasUsers() const;
+
+  // Returns true if there are streams created by MakeMixableStream() which
+  // are not closed yet.
+  bool HasStreams() const;
+
+  // Creates an AudioOutputStream with the mixer's parameters whose audio is
+  // mixed into the physical stream. As for any AudioOutputStream, the caller
+  // must Close() it, and must do so before the mixer is destroyed.
+  media::AudioOutputStream* MakeMixableStream();
+
+  // AudioSourceCallback implementation, called by the physical stream.
+  int OnMoreData(base::TimeDelta delay,
+                 base::TimeTicks delay_timestamp,
+                 int prior_frames_skipped,
+                 media::AudioBus* dest) final;
+  void OnError(ErrorType type) final;
+
+  // AudioDeviceListener implementation.
+  void OnDeviceChange() final;
+
+ private:
+  class MixableStream;
+
+  // Called by MixableStream on the audio manager thread. StopStream() returns
+  // only once the device thread is done rendering |stream|.
+  bool OpenStream();
+  void StartStream(MixableStream* stream);
+  void StopStream(MixableStream* stream);
+  void CloseStream(bool was_opened);
+
+  // Creates and opens |device_stream_|. Returns false on failure, leaving
+  // |device_stream_| null.
+  bool OpenDeviceStream();
+  void CloseDeviceStream();
+
+  media::AudioManager* const audio_manager_;
+  const std::string device_id_;
+  const media::AudioParameters params_;
+
+  // The physical stream, non-null while any mixable stream is open, unless
+  // re-creating it on a device change failed.
+  media::AudioOutputStream* device_stream_ = nullptr;
+
+  // See AddUser().
+  int user_count_ = 0;
+
+  // Number of mixable streams which are not closed yet, which of them are
+  // opened, and which of them are playing.
+  int stream_count_ = 0;
+  int open_stream_count_ = 0;
+  int playing_stream_count_ = 0;
+
+  // Guards the set of playing streams and their volumes, which are shared
+  // between the audio manager thread and the device thread. Only held briefly;
+  // the sources are not called under it, so that SetVolume() and Start() do not
+  // wait for a render.
+  base::Lock lock_;
+  base::flat_set<MixableStream*> playing_streams_;
+
+  // Held by OnMoreData() for the whole render, so that StopStream() can wait
+  // for a render that picked up the stream before it was removed.
+  base::Lock render_lock_;
+
+  // Used by OnMoreData() on the device thread, under |render_lock_|. The
+  // snapshot of the playing streams and their volumes, and the buffer each
+  // stream is rendered into before being mixed into the destination.
+  std::vector<std::pair<MixableStream*, double>> render_streams_;
+  std::unique_ptr<media::AudioBus> stream_bus_;
+
+  THREAD_CHECKER(thread_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(OutputDeviceMixer);
+};
+
+}  // namespace audio
+
+#endif  // SERVICES_AUDIO_OUTPUT_DEVICE_MIXER_H_
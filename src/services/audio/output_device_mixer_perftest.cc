@@ -0,0 +1,148 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "base/time/time_override.h"
+#include "media/audio/fake_audio_log_factory.h"
+#include "media/audio/fake_audio_manager.h"
+#include "media/audio/test_audio_thread.h"
+#include "media/base/audio_bus.h"
+#include "media/base/audio_parameters.h"
+#include "services/audio/output_device_mixer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_result_reporter.h"
+
+namespace audio {
+
+namespace {
+
+// Amount of audio played per benchmark run.
+constexpr base::TimeDelta kMediaDuration = base::TimeDelta::FromSeconds(60);
+
+constexpr int kSampleRate = 48000;
+constexpr int kFramesPerBuffer = 480;
+
+// Writes a ramp, standing in for the renderer audio read by SyncReader, and
+// accumulates the delay reported with each buffer.
+class RampSource : public media::AudioOutputStream::AudioSourceCallback {
+ public:
+  RampSource() = default;
+
+  int OnMoreData(base::TimeDelta delay,
+                 base::TimeTicks delay_timestamp,
+                 int prior_frames_skipped,
+                 media::AudioBus* dest) final {
+    for (int ch = 0; ch < dest->channels(); ++ch) {
+      float* data = dest->channel(ch);
+      for (int i = 0; i < dest->frames(); ++i)
+        data[i] = (i % 100) / 100.0f;
+    }
+    total_delay_ += delay;
+    ++buffer_count_;
+    return dest->frames();
+  }
+
+  void OnError(ErrorType type) final {}
+
+  base::TimeDelta total_delay() const { return total_delay_; }
+  int64_t buffer_count() const { return buffer_count_; }
+
+ private:
+  base::TimeDelta total_delay_;
+  int64_t buffer_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(RampSource);
+};
+
+}  // namespace
+
+// Plays |kMediaDuration| of audio from a number of streams to a fake device,
+// either through one physical stream each or mixed by an OutputDeviceMixer.
+// Time is mocked, so the measured time is the CPU cost of the output path,
+// including the fake device's AudioBus handling, per second of audio.
+class OutputDeviceMixerPerfTest : public testing::Test {
+ public:
+  OutputDeviceMixerPerfTest()
+      : task_environment_(base::test::TaskEnvironment::TimeSource::MOCK_TIME),
+        audio_manager_(std::make_unique<media::TestAudioThread>(),
+                       &fake_audio_log_factory_),
+        params_(media::AudioParameters::AUDIO_PCM_LOW_LATENCY,
+                media::CHANNEL_LAYOUT_STEREO,
+                kSampleRate,
+                kFramesPerBuffer) {}
+
+  ~OutputDeviceMixerPerfTest() override { audio_manager_.Shutdown(); }
+
+ protected:
+  void RunPlayBenchmark(int stream_count, bool mixed) {
+    OutputDeviceMixer mixer(&audio_manager_, std::string(), params_);
+    std::vector<media::AudioOutputStream*> streams;
+    std::vector<std::unique_ptr<RampSource>> sources;
+    for (int i = 0; i < stream_count; ++i) {
+      media::AudioOutputStream* stream =
+          mixed ? mixer.MakeMixableStream()
+                : audio_manager_.MakeAudioOutputStreamProxy(params_,
+                                                            std::string());
+      ASSERT_TRUE(stream->Open());
+      sources.push_back(std::make_unique<RampSource>());
+      stream->SetVolume(0.5);
+      stream->Start(sources.back().get());
+      streams.push_back(stream);
+    }
+
+    const base::TimeTicks start = base::subtle::TimeTicksNowIgnoringOverride();
+    task_environment_.FastForwardBy(kMediaDuration);
+    const base::TimeDelta elapsed =
+        base::subtle::TimeTicksNowIgnoringOverride() - start;
+
+    for (media::AudioOutputStream* stream : streams) {
+      stream->Stop();
+      stream->Close();
+    }
+    task_environment_.RunUntilIdle();
+
+    base::TimeDelta total_delay;
+    int64_t buffer_count = 0;
+    for (const auto& source : sources) {
+      total_delay += source->total_delay();
+      buffer_count += source->buffer_count();
+    }
+    ASSERT_GT(buffer_count, 0);
+
+    perf_test::PerfResultReporter reporter(
+        "audio_output_device_mixer",
+        base::StringPrintf("%s_%d_streams", mixed ? "mixed" : "unmixed",
+                           stream_count));
+    reporter.RegisterImportantMetric("_cpu_per_media_second", "us");
+    reporter.RegisterImportantMetric("_output_delay", "ms");
+    reporter.AddResult("_cpu_per_media_second",
+                       elapsed.InMicrosecondsF() / kMediaDuration.InSecondsF());
+    reporter.AddResult("_output_delay",
+                       total_delay.InMillisecondsF() / buffer_count);
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  media::FakeAudioLogFactory fake_audio_log_factory_;
+  media::FakeAudioManager audio_manager_;
+  const media::AudioParameters params_;
+};
+
+TEST_F(OutputDeviceMixerPerfTest, Play) {
+  const int kStreamCounts[] = {1, 4, 16};
+  for (int stream_count : kStreamCounts) {
+    RunPlayBenchmark(stream_count, false);
+    RunPlayBenchmark(stream_count, true);
+  }
+}
+
+}  // namespace audio
@@ -0,0 +1,295 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/audio/output_device_mixer.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "base/macros.h"
+#include "base/test/task_environment.h"
+#include "base/time/time.h"
+#include "media/audio/fake_audio_log_factory.h"
+#include "media/audio/fake_audio_manager.h"
+#include "media/audio/mock_audio_source_callback.h"
+#include "media/audio/test_audio_thread.h"
+#include "media/base/audio_bus.h"
+#include "media/base/audio_parameters.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::NiceMock;
+
+using media::AudioBus;
+using media::AudioOutputStream;
+using media::AudioParameters;
+
+using ErrorType = media::AudioOutputStream::AudioSourceCallback::ErrorType;
+
+namespace audio {
+
+namespace {
+
+constexpr char kDeviceId[] = "device";
+constexpr int kSampleRate = 48000;
+constexpr int kFramesPerBuffer = 480;
+
+// A physical stream which is pulled by the test rather than by a device.
+class FakeDeviceStream final : public AudioOutputStream {
+ public:
+  explicit FakeDeviceStream(FakeDeviceStream** last_closed)
+      : last_closed_(last_closed) {}
+  ~FakeDeviceStream() final = default;
+
+  bool Open() final { return true; }
+  void Start(AudioSourceCallback* callback) final { callback_ = callback; }
+  void Stop() final { callback_ = nullptr; }
+  void SetVolume(double volume) final {}
+  void GetVolume(double* volume) final { *volume = 1.0; }
+  void Close() final {
+    *last_closed_ = this;
+    delete this;
+  }
+  void Flush() final {}
+
+  bool playing() const { return callback_ != nullptr; }
+  AudioSourceCallback* callback() const { return callback_; }
+
+ private:
+  FakeDeviceStream** const last_closed_;
+  AudioSourceCallback* callback_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(FakeDeviceStream);
+};
+
+class AudioManagerForMixerTest final : public media::FakeAudioManager {
+ public:
+  AudioManagerForMixerTest()
+      : media::FakeAudioManager(std::make_unique<media::TestAudioThread>(),
+                                &fake_audio_log_factory_) {}
+  ~AudioManagerForMixerTest() final = default;
+
+  AudioOutputStream* MakeAudioOutputStreamProxy(
+      const AudioParameters& params,
+      const std::string& device_id) final {
+    ++created_stream_count_;
+    last_created_stream_ = new FakeDeviceStream(&last_closed_stream_);
+    return last_created_stream_;
+  }
+
+  int created_stream_count() const { return created_stream_count_; }
+  FakeDeviceStream* last_created_stream() const {
+    return last_created_stream_;
+  }
+  FakeDeviceStream* last_closed_stream() const { return last_closed_stream_; }
+
+ private:
+  media::FakeAudioLogFactory fake_audio_log_factory_;
+  int created_stream_count_ = 0;
+  FakeDeviceStream* last_created_stream_ = nullptr;
+  FakeDeviceStream* last_closed_stream_ = nullptr;
+};
+
+// Fills the buffer with |value|.
+class ConstantSource : public AudioOutputStream::AudioSourceCallback {
+ public:
+  explicit ConstantSource(float value) : value_(value) {}
+
+  int OnMoreData(base::TimeDelta delay,
+                 base::TimeTicks delay_timestamp,
+                 int prior_frames_skipped,
+                 AudioBus* dest) final {
+    last_delay_ = delay;
+    for (int ch = 0; ch < dest->channels(); ++ch)
+      std::fill_n(dest->channel(ch), dest->frames(), value_);
+    return dest->frames();
+  }
+
+  void OnError(ErrorType type) final {}
+
+  base::TimeDelta last_delay() const { return last_delay_; }
+
+ private:
+  const float value_;
+  base::TimeDelta last_delay_;
+};
+
+}  // namespace
+
+class OutputDeviceMixerTest : public ::testing::Test {
+ public:
+  OutputDeviceMixerTest()
+      : params_(AudioParameters::AUDIO_PCM_LOW_LATENCY,
+                media::CHANNEL_LAYOUT_STEREO,
+                kSampleRate,
+                kFramesPerBuffer),
+        mixer_(&audio_manager_, kDeviceId, params_),
+        dest_(AudioBus::Create(params_)) {}
+
+  ~OutputDeviceMixerTest() override { audio_manager_.Shutdown(); }
+
+ protected:
+  // Pulls one buffer from the mixer as the device would, and returns the
+  // first sample.
+  float PullBuffer(base::TimeDelta delay = base::TimeDelta()) {
+    dest_->Zero();
+    EXPECT_EQ(kFramesPerBuffer,
+              mixer_.OnMoreData(delay, base::TimeTicks::Now(), 0, dest_.get()));
+    return dest_->channel(0)[0];
+  }
+
+  base::test::TaskEnvironment task_environment_;
+  AudioManagerForMixerTest audio_manager_;
+  const AudioParameters params_;
+  OutputDeviceMixer mixer_;
+  std::unique_ptr<AudioBus> dest_;
+};
+
+TEST_F(OutputDeviceMixerTest, MixesStreamsIntoOneDeviceStream) {
+  AudioOutputStream* stream1 = mixer_.MakeMixableStream();
+  AudioOutputStream* stream2 = mixer_.MakeMixableStream();
+  ASSERT_TRUE(stream1->Open());
+  ASSERT_TRUE(stream2->Open());
+  EXPECT_EQ(1, audio_manager_.created_stream_count());
+  FakeDeviceStream* device_stream = audio_manager_.last_created_stream();
+
+  ConstantSource source1(0.25f);
+  ConstantSource source2(0.5f);
+  stream1->Start(&source1);
+  stream2->Start(&source2);
+  stream2->SetVolume(0.5);
+  EXPECT_TRUE(device_stream->playing());
+  EXPECT_EQ(&mixer_, device_stream->callback());
+
+  const base::TimeDelta kDelay = base::TimeDelta::FromMilliseconds(20);
+  EXPECT_FLOAT_EQ(0.5f, PullBuffer(kDelay));
+  EXPECT_EQ(kDelay, source1.last_delay());
+  EXPECT_EQ(kDelay, source2.last_delay());
+
+  stream1->Stop();
+  EXPECT_TRUE(device_stream->playing());
+  EXPECT_FLOAT_EQ(0.25f, PullBuffer());
+
+  stream2->Stop();
+  EXPECT_FALSE(device_stream->playing());
+
+  stream1->Close();
+  EXPECT_EQ(nullptr, audio_manager_.last_closed_stream());
+  EXPECT_TRUE(mixer_.HasStreams());
+  stream2->Close();
+  EXPECT_EQ(device_stream, audio_manager_.last_closed_stream());
+  EXPECT_FALSE(mixer_.HasStreams());
+}
+
+TEST_F(OutputDeviceMixerTest, ReopensDeviceStreamAfterLastStreamClosed) {
+  AudioOutputStream* stream = mixer_.MakeMixableStream();
+  ASSERT_TRUE(stream->Open());
+  stream->Close();
+  EXPECT_EQ(audio_manager_.last_created_stream(),
+            audio_manager_.last_closed_stream());
+
+  stream = mixer_.MakeMixableStream();
+  ASSERT_TRUE(stream->Open());
+  EXPECT_EQ(2, audio_manager_.created_stream_count());
+  stream->Close();
+}
+
+TEST_F(OutputDeviceMixerTest, DeviceChangeRestartsDeviceStream) {
+  AudioOutputStream* stream = mixer_.MakeMixableStream();
+  ASSERT_TRUE(stream->Open());
+  ConstantSource source(0.25f);
+  stream->Start(&source);
+  FakeDeviceStream* old_device_stream = audio_manager_.last_created_stream();
+
+  mixer_.OnDeviceChange();
+  EXPECT_EQ(old_device_stream, audio_manager_.last_closed_stream());
+  EXPECT_EQ(2, audio_manager_.created_stream_count());
+  EXPECT_TRUE(audio_manager_.last_created_stream()->playing());
+  EXPECT_FLOAT_EQ(0.25f, PullBuffer());
+
+  stream->Stop();
+  stream->Close();
+}
+
+TEST_F(OutputDeviceMixerTest, ForwardsErrorsToPlayingStreams) {
+  AudioOutputStream* playing_stream = mixer_.MakeMixableStream();
+  AudioOutputStream* paused_stream = mixer_.MakeMixableStream();
+  ASSERT_TRUE(playing_stream->Open());
+  ASSERT_TRUE(paused_stream->Open());
+
+  NiceMock<media::MockAudioSourceCallback> playing_source;
+  NiceMock<media::MockAudioSourceCallback> paused_source;
+  playing_stream->Start(&playing_source);
+  paused_stream->Start(&paused_source);
+  paused_stream->Stop();
+
+  EXPECT_CALL(playing_source, OnError(ErrorType::kUnknown));
+  EXPECT_CALL(paused_source, OnError(_)).Times(0);
+  mixer_.OnError(ErrorType::kUnknown);
+
+  playing_stream->Stop();
+  playing_stream->Close();
+  paused_stream->Close();
+}
+
+TEST_F(OutputDeviceMixerTest, HandlesDeviceChangeOnce) {
+  AudioOutputStream* stream = mixer_.MakeMixableStream();
+  ASSERT_TRUE(stream->Open());
+  NiceMock<media::MockAudioSourceCallback> source;
+  stream->Start(&source);
+  FakeDeviceStream* old_device_stream = audio_manager_.last_created_stream();
+
+  // A device change is both reported as an error by the device stream and
+  // notified to the listener. The device stream is re-created once, and the
+  // source keeps playing through it without being told.
+  EXPECT_CALL(source, OnError(_)).Times(0);
+  mixer_.OnError(ErrorType::kDeviceChange);
+  mixer_.OnDeviceChange();
+  task_environment_.RunUntilIdle();
+  EXPECT_EQ(old_device_stream, audio_manager_.last_closed_stream());
+  EXPECT_EQ(2, audio_manager_.created_stream_count());
+  EXPECT_TRUE(audio_manager_.last_created_stream()->playing());
+
+  stream->Stop();
+  stream->Close();
+}
+
+// Sources are rendered without the lock taken by the stream controls, which
+// would otherwise wait for every source's render.
+TEST_F(OutputDeviceMixerTest, RendersSourcesWithoutBlockingControls) {
+  AudioOutputStream* stream = mixer_.MakeMixableStream();
+  ASSERT_TRUE(stream->Open());
+  NiceMock<media::MockAudioSourceCallback> source;
+  EXPECT_CALL(source, OnMoreData(_, _, _, _))
+      .WillOnce(Invoke([stream](base::TimeDelta, base::TimeTicks, int,
+                                AudioBus* dest) {
+        stream->SetVolume(0.5);
+        dest->Zero();
+        return dest->frames();
+      }));
+  stream->Start(&source);
+  PullBuffer();
+
+  double volume = 0.0;
+  stream->GetVolume(&volume);
+  EXPECT_EQ(0.5, volume);
+
+  stream->Stop();
+  stream->Close();
+}
+
+TEST_F(OutputDeviceMixerTest, TracksUsers) {
+  EXPECT_FALSE(mixer_.HasUsers());
+  mixer_.AddUser();
+  mixer_.AddUser();
+  mixer_.RemoveUser();
+  EXPECT_TRUE(mixer_.HasUsers());
+  mixer_.RemoveUser();
+  EXPECT_FALSE(mixer_.HasUsers());
+}
+
+}  // namespace audio
@@ -40,7 +40,8 @@ OutputStream::OutputStream(
     const std::string& output_device_id,
     const media::AudioParameters& params,
     LoopbackCoordinator* coordinator,
-    const base::UnguessableToken& loopback_group_id)
+    const base::UnguessableToken& loopback_group_id,
+    OutputDeviceMixer* output_mixer)
     : foreign_socket_(),
       delete_callback_(std::move(delete_callback)),
       receiver_(this, std::move(stream_receiver)),
@@ -53,7 +54,12 @@ OutputStream::OutputStream(
                    : base::DoNothing(),
               params,
               &foreign_socket_),
-      controller_(audio_manager, this, params, output_device_id, &reader_),
+      controller_(audio_manager,
+                  this,
+                  params,
+                  output_device_id,
+                  &reader_,
+                  output_mixer),
       loopback_group_id_(loopback_group_id) {
   DCHECK(receiver_.is_bound());
   DCHECK(created_callback);
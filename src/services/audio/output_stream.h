@@ -41,6 +41,8 @@ class AudioParameters;
 
 namespace audio {
 
+class OutputDeviceMixer;
+
 class OutputStream final : public media::mojom::AudioOutputStream,
                            public OutputController::EventHandler {
  public:
@@ -59,7 +61,8 @@ class OutputStream final : public media::mojom::AudioOutputStream,
       const std::string& output_device_id,
       const media::AudioParameters& params,
       LoopbackCoordinator* coordinator,
-      const base::UnguessableToken& loopback_group_id);
+      const base::UnguessableToken& loopback_group_id,
+      OutputDeviceMixer* output_mixer);
 
   ~OutputStream() final;
 
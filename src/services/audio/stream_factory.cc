@@ -7,14 +7,18 @@
 #include <utility>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
+#include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/trace_event/trace_event.h"
 #include "base/unguessable_token.h"
 #include "build/chromecast_buildflags.h"
 #include "media/audio/audio_device_description.h"
+#include "media/audio/audio_features.h"
 #include "services/audio/input_stream.h"
 #include "services/audio/local_muter.h"
 #include "services/audio/loopback_stream.h"
+#include "services/audio/output_device_mixer.h"
 #include "services/audio/output_stream.h"
 #include "services/audio/user_input_monitor.h"
 
@@ -108,7 +112,8 @@ void StreamFactory::CreateOutputStream(
   output_streams_.insert(std::make_unique<OutputStream>(
       std::move(created_callback), std::move(deleter_callback),
       std::move(stream_receiver), std::move(observer), std::move(log),
-      audio_manager_, device_id_or_group_id, params, &coordinator_, group_id));
+      audio_manager_, device_id_or_group_id, params, &coordinator_, group_id,
+      GetOutputDeviceMixer(device_id_or_group_id, params)));
 }
 
 void StreamFactory::BindMuter(
@@ -199,6 +204,13 @@ void StreamFactory::DestroyOutputStream(OutputStream* stream) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(owning_sequence_);
   size_t erased = output_streams_.erase(stream);
   DCHECK_EQ(1u, erased);
+
+  // The mixer of the last stream to a device is not needed anymore. Streams
+  // which hold no mixable stream, e.g. while muted, still use their mixer.
+  base::EraseIf(output_mixers_,
+                [](const std::unique_ptr<OutputDeviceMixer>& mixer) {
+                  return !mixer->HasUsers();
+                });
 }
 
 void StreamFactory::DestroyMuter(LocalMuter* muter) {
@@ -245,4 +257,32 @@ void StreamFactory::DestroyLoopbackStream(LoopbackStream* stream) {
   }
 }
 
+OutputDeviceMixer* StreamFactory::GetOutputDeviceMixer(
+    const std::string& device_id,
+    const media::AudioParameters& params) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(owning_sequence_);
+  // Only PCM streams to a device are mixed; fake streams are not played out,
+  // and bitstream formats are decoded by the device.
+  if (!base::FeatureList::IsEnabled(features::kAudioServiceOutputDeviceMixer) ||
+      params.format() != media::AudioParameters::AUDIO_PCM_LOW_LATENCY) {
+    return nullptr;
+  }
+
+  // "" and "default" both name the default device, which must get a single
+  // mixer.
+  const std::string mixer_device_id =
+      media::AudioDeviceDescription::IsDefaultDevice(device_id)
+          ? media::AudioDeviceDescription::kDefaultDeviceId
+          : device_id;
+  for (const std::unique_ptr<OutputDeviceMixer>& mixer : output_mixers_) {
+    if (mixer->device_id() == mixer_device_id &&
+        mixer->params().Equals(params)) {
+      return mixer.get();
+    }
+  }
+  output_mixers_.push_back(std::make_unique<OutputDeviceMixer>(
+      audio_manager_, mixer_device_id, params));
+  return output_mixers_.back().get();
+}
+
 }  // namespace audio
@@ -36,6 +36,7 @@ namespace audio {
 class InputStream;
 class LocalMuter;
 class LoopbackStream;
+class OutputDeviceMixer;
 class OutputStream;
 
 // This class is used to provide the StreamFactory interface. It will typically
@@ -97,6 +98,11 @@ class StreamFactory final : public mojom::StreamFactory {
   void DestroyMuter(LocalMuter* muter);
   void DestroyLoopbackStream(LoopbackStream* stream);
 
+  // Returns the mixer for output streams with |params| to |device_id|,
+  // creating it if needed, or null if such streams are not to be mixed.
+  OutputDeviceMixer* GetOutputDeviceMixer(const std::string& device_id,
+                                          const media::AudioParameters& params);
+
   SEQUENCE_CHECKER(owning_sequence_);
 
   media::AudioManager* const audio_manager_;
@@ -109,6 +115,7 @@ class StreamFactory final : public mojom::StreamFactory {
   base::Thread loopback_worker_thread_;
   std::vector<std::unique_ptr<LoopbackStream>> loopback_streams_;
   InputStreamSet input_streams_;
+  std::vector<std::unique_ptr<OutputDeviceMixer>> output_mixers_;
   OutputStreamSet output_streams_;
 
   base::WeakPtrFactory<StreamFactory> weak_ptr_factory_{this};
@@ -114,8 +114,10 @@ SyncReader::~SyncReader() {
       ? LogAudioGlitchResult(AUDIO_RENDERER_AUDIO_GLITCHES)
       : LogAudioGlitchResult(AUDIO_RENDERER_NO_AUDIO_GLITCHES);
   log_callback_.Run(base::StringPrintf(
-      "ASR: number of detected audio glitches: %" PRIuS " out of %" PRIuS,
-      renderer_missed_callback_count_, renderer_callback_count_));
+      "ASR: number of detected audio glitches: %" PRIuS " out of %" PRIuS
+      ", longest wait for renderer data: %" PRId64 " us",
+      renderer_missed_callback_count_, renderer_callback_count_,
+      longest_wait_for_data_.InMicroseconds()));
 }
 
 bool SyncReader::IsValid() const {
@@ -281,6 +283,8 @@ bool SyncReader::WaitUntilDataIsReady() {
     return false;
   }
 
+  longest_wait_for_data_ =
+      std::max(longest_wait_for_data_, base::TimeTicks::Now() - start_time);
   return true;
 }
 
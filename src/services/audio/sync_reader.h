@@ -93,6 +93,11 @@ class SyncReader : public OutputController::SyncReader {
   size_t renderer_missed_callback_count_;
   size_t trailing_renderer_missed_callback_count_;
 
+  // The longest time WaitUntilDataIsReady() waited for data that did arrive
+  // in time. Reported with the glitch summary; a value close to
+  // |maximum_wait_time_| means the renderer is barely keeping up.
+  base::TimeDelta longest_wait_for_data_;
+
   // The maximum amount of time to wait for data from the renderer.  Calculated
   // from the parameters given at construction.
   base::TimeDelta maximum_wait_time_;
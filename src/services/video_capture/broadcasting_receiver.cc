@@ -4,6 +4,8 @@
 
 #include "services/video_capture/broadcasting_receiver.h"
 
+#include <algorithm>
+
 #include "base/bind.h"
 #include "build/build_config.h"
 #include "mojo/public/cpp/bindings/self_owned_receiver.h"
@@ -310,11 +312,19 @@ void BroadcastingReceiver::OnFrameReadyInBuffer(
   auto buffer_context_iter = FindUnretiredBufferContextFromBufferId(buffer_id);
   CHECK(buffer_context_iter != buffer_contexts_.end());
   auto& buffer_context = *buffer_context_iter;
+
+  // The last client to receive the frame takes |frame_info| itself, so a
+  // single consumer costs no copy of the frame metadata.
+  size_t remaining_clients = std::count_if(
+      clients_.begin(), clients_.end(),
+      [](const auto& entry) { return !entry.second.is_suspended(); });
+  if (!remaining_clients)
+    return;
+  if (access_permission)
+    buffer_context.set_access_permission(std::move(access_permission));
   for (auto& client : clients_) {
     if (client.second.is_suspended())
       continue;
-    if (access_permission)
-      buffer_context.set_access_permission(std::move(access_permission));
     mojo::PendingRemote<mojom::ScopedAccessPermission>
         consumer_access_permission;
     mojo::MakeSelfOwnedReceiver(
@@ -324,7 +334,8 @@ void BroadcastingReceiver::OnFrameReadyInBuffer(
         consumer_access_permission.InitWithNewPipeAndPassReceiver());
     client.second.client()->OnFrameReadyInBuffer(
         buffer_context.buffer_context_id(), frame_feedback_id,
-        std::move(consumer_access_permission), frame_info.Clone());
+        std::move(consumer_access_permission),
+        --remaining_clients ? frame_info.Clone() : std::move(frame_info));
     buffer_context.IncreaseConsumerCount();
   }
 }
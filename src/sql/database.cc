@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
+
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
@@ -241,6 +243,9 @@ Database::Database()
       page_size_(kDefaultPageSize),
       cache_size_(0),
       exclusive_locking_(false),
+      wal_mode_(false),
+      manual_wal_checkpoints_(false),
+      read_only_(false),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
@@ -994,6 +999,30 @@ bool Database::Delete(const base::FilePath& path) {
   return !journal_exists && !wal_exists && !path_exists;
 }
 
+bool Database::CheckpointDatabase() {
+  TRACE_EVENT0("sql", "Database::CheckpointDatabase");
+
+  if (!db_) {
+    DCHECK(poisoned_) << "Cannot checkpoint null db";
+    return false;
+  }
+  DCHECK(wal_mode_) << "Only WAL-mode databases have a log to checkpoint";
+
+  base::Optional<base::ScopedBlockingCall> scoped_blocking_call;
+  InitScopedBlockingCall(FROM_HERE, &scoped_blocking_call);
+
+  // SQLITE_CHECKPOINT_PASSIVE copies as many frames as possible without taking
+  // locks that readers or the writer may hold, so it never waits on them.
+  int rc = sqlite3_wal_checkpoint_v2(db_, /*zDb=*/nullptr,
+                                     SQLITE_CHECKPOINT_PASSIVE,
+                                     /*pnLog=*/nullptr, /*pnCkpt=*/nullptr);
+  if (rc != SQLITE_OK) {
+    OnSqliteError(rc, nullptr, "-- sqlite3_wal_checkpoint_v2()");
+    return false;
+  }
+  return true;
+}
+
 bool Database::BeginTransaction() {
   TRACE_EVENT0("sql", "Database::BeginTransaction");
 
@@ -1217,6 +1246,7 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
 
   scoped_refptr<StatementRef> statement = GetUniqueStatement(sql);
   if (statement->is_valid()) {
+    statement->set_statement_id(id);
     statement_cache_[id] = statement;  // Only cache valid statements.
     DCHECK_EQ(std::string(sqlite3_sql(statement->stmt())), std::string(sql))
         << "Input SQL does not match SQLite's normalized version";
@@ -1264,6 +1294,34 @@ scoped_refptr<Database::StatementRef> Database::GetUntrackedStatement(
   return GetStatementImpl(nullptr, sql);
 }
 
+Database::StatementStats::StatementStats() = default;
+Database::StatementStats::StatementStats(const StatementStats&) = default;
+Database::StatementStats& Database::StatementStats::operator=(
+    const StatementStats&) = default;
+Database::StatementStats::~StatementStats() = default;
+
+void Database::EnableStatementProfiling(
+    base::TimeDelta slow_statement_threshold) {
+  statement_profiling_enabled_ = true;
+  slow_statement_threshold_ = slow_statement_threshold;
+}
+
+void Database::DisableStatementProfiling() {
+  statement_profiling_enabled_ = false;
+}
+
+base::Optional<Database::StatementStats> Database::GetStatementStats(
+    StatementID id) const {
+  auto it = statement_stats_.find(id);
+  if (it == statement_stats_.end())
+    return base::nullopt;
+  return it->second;
+}
+
+void Database::ResetStatementStats() {
+  statement_stats_.clear();
+}
+
 std::string Database::GetSchema() const {
   // The ORDER BY should not be necessary, but relying on organic
   // order for something like this is questionable.
@@ -1427,10 +1485,17 @@ bool Database::OpenInternal(const std::string& file_name,
   // disparate features with their own databases, and having separate page
   // caches makes it easier to reason about each feature's performance in
   // isolation.
-  int err = sqlite3_open_v2(
-      file_name.c_str(), &db_,
-      SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_PRIVATECACHE,
-      vfs_name);
+  DCHECK(!read_only_ || !exclusive_locking_)
+      << "Read-only connections cannot use exclusive locking.";
+  DCHECK(!wal_mode_ || !exclusive_locking_)
+      << "WAL mode cannot use exclusive locking.";
+  DCHECK(wal_mode_ || !manual_wal_checkpoints_)
+      << "Manual checkpoints require WAL mode.";
+  const int open_flags =
+      (read_only_ ? SQLITE_OPEN_READONLY
+                  : SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE) |
+      SQLITE_OPEN_PRIVATECACHE;
+  int err = sqlite3_open_v2(file_name.c_str(), &db_, open_flags, vfs_name);
   if (err != SQLITE_OK) {
     // Extended error codes cannot be enabled until a handle is
     // available, fetch manually.
@@ -1501,7 +1566,21 @@ bool Database::OpenInternal(const std::string& file_name,
   // TRUNCATE should be faster than DELETE because it won't need directory
   // changes for each transaction.  PERSIST may break the spirit of using
   // secure_delete.
-  ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  // WAL - append changes to a -wal file, checkpointed into the database later.
+  // Readers on other connections see a consistent snapshot without blocking,
+  // or being blocked by, the writer.
+  //
+  // The journal mode is a property of the database file in WAL mode, so
+  // read-only connections leave it alone and inherit the writer's choice.
+  if (wal_mode_) {
+    ignore_result(Execute("PRAGMA journal_mode=WAL"));
+    // The owner runs checkpoints through CheckpointDatabase(), so that they do
+    // not land on whichever commit happens to cross the size threshold.
+    if (manual_wal_checkpoints_)
+      ignore_result(Execute("PRAGMA wal_autocheckpoint=0"));
+  } else if (!read_only_) {
+    ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  }
 
   const base::TimeDelta kBusyTimeout =
       base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
@@ -1541,7 +1620,11 @@ bool Database::OpenInternal(const std::string& file_name,
   // safe range to memory-map based on past regular I/O.  This value will be
   // capped by SQLITE_MAX_MMAP_SIZE, which could be different between 32-bit and
   // 64-bit platforms.
-  size_t mmap_size = mmap_disabled_ ? 0 : GetAppropriateMmapSize();
+  //
+  // GetAppropriateMmapSize() records its progress in the database, which
+  // read-only connections cannot do, so they do not memory-map.
+  size_t mmap_size =
+      (mmap_disabled_ || read_only_) ? 0 : GetAppropriateMmapSize();
   std::string mmap_sql =
       base::StringPrintf("PRAGMA mmap_size=%" PRIuS, mmap_size);
   ignore_result(Execute(mmap_sql.c_str()));
@@ -1579,6 +1662,49 @@ void Database::DoRollback() {
   needs_rollback_ = false;
 }
 
+int Database::GetPageCacheMissCount() const {
+  if (!db_)
+    return 0;
+
+  int cache_misses = 0;
+  int highwater = 0;
+  sqlite3_db_status(db_, SQLITE_DBSTATUS_CACHE_MISS, &cache_misses, &highwater,
+                    /*resetFlg=*/0);
+  return cache_misses;
+}
+
+void Database::RecordStatementExecution(const StatementRef& ref,
+                                        const StatementStats& execution) {
+  DCHECK(statement_profiling_enabled_);
+  DCHECK(ref.is_valid());
+
+  const char* sql = sqlite3_sql(ref.stmt());
+  const bool slow = execution.total_time >= slow_statement_threshold_;
+  if (slow) {
+    TRACE_EVENT_INSTANT2("sql", "Database::SlowStatement",
+                         TRACE_EVENT_SCOPE_THREAD, "sql", TRACE_STR_COPY(sql),
+                         "duration_ms", execution.total_time.InMillisecondsF());
+  }
+
+  // Only cached statements have a stable identity to aggregate under.
+  if (!ref.statement_id())
+    return;
+
+  StatementStats& stats = statement_stats_[*ref.statement_id()];
+  if (stats.sql.empty())
+    stats.sql = sql;
+  ++stats.executions;
+  if (slow)
+    ++stats.slow_executions;
+  stats.steps += execution.steps;
+  stats.rows += execution.rows;
+  stats.total_time += execution.total_time;
+  stats.max_time = std::max(stats.max_time, execution.total_time);
+  stats.pages_read += execution.pages_read;
+  stats.vm_steps += execution.vm_steps;
+  stats.full_scan_steps += execution.full_scan_steps;
+}
+
 void Database::StatementRefCreated(StatementRef* ref) {
   DCHECK(!open_statements_.count(ref))
       << __func__ << " already called with this statement";
@@ -23,6 +23,7 @@
 #include "base/optional.h"
 #include "base/sequence_checker.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/time/time.h"
 #include "sql/internal_api_token.h"
 #include "sql/statement_id.h"
 
@@ -97,8 +98,43 @@ class COMPONENT_EXPORT(SQL) Database {
   // transaction, which means there may be less time spent initializing the
   // next transaction because it doesn't have to re-aquire locks.
   //
-  // This must be called before Open() to have an effect.
-  void set_exclusive_locking() { exclusive_locking_ = true; }
+  // This must be called before Open() to have an effect, and cannot be combined
+  // with set_wal_mode(), as other connections could not read the database.
+  void set_exclusive_locking() {
+    DCHECK(!wal_mode_) << "WAL mode cannot use exclusive locking.";
+    exclusive_locking_ = true;
+  }
+
+  // Call to open the database in write-ahead logging (WAL) mode. In WAL mode,
+  // readers on other connections (see ReadOnlyDatabasePool) do not block the
+  // writer and are not blocked by it.
+  //
+  // SQLite checkpoints the log into the database file on the commit that grows
+  // it past 1000 pages, unless set_manual_wal_checkpoints() is called.
+  //
+  // This must be called before Open() to have an effect, and cannot be combined
+  // with set_exclusive_locking().
+  void set_wal_mode() {
+    DCHECK(!exclusive_locking_) << "WAL mode cannot use exclusive locking.";
+    wal_mode_ = true;
+  }
+
+  // Call to turn off automatic checkpoints in WAL mode, so that commits never
+  // pay for copying the log back into the database file. The owner must then
+  // call CheckpointDatabase() periodically, for example from a BEST_EFFORT
+  // task, otherwise the log grows without bound.
+  //
+  // This must be called before Open() to have an effect, along with
+  // set_wal_mode().
+  void set_manual_wal_checkpoints() { manual_wal_checkpoints_ = true; }
+
+  // Call to open the database without write access. The database file must
+  // already exist. Intended for additional connections to a database whose
+  // writer uses set_wal_mode().
+  //
+  // This must be called before Open() to have an effect, and cannot be combined
+  // with set_exclusive_locking().
+  void set_read_only() { read_only_ = true; }
 
   // Call to use alternative status-tracking for mmap.  Usually this is tracked
   // in the meta table, but some databases have no meta table.
@@ -298,6 +334,14 @@ class COMPONENT_EXPORT(SQL) Database {
   // existed, this will return true.
   static bool Delete(const base::FilePath& path);
 
+  // Copies the contents of the write-ahead log back into the database file,
+  // without waiting for readers or writers on other connections. Pages that
+  // are still needed by active readers stay in the log for a later checkpoint.
+  // Returns true if the checkpoint ran, even if it was partial.
+  //
+  // Only meaningful for databases opened with set_wal_mode().
+  bool CheckpointDatabase();
+
   // Transactions --------------------------------------------------------------
 
   // Transaction management. We maintain a virtual transaction stack to emulate
@@ -396,6 +440,62 @@ class COMPONENT_EXPORT(SQL) Database {
   // See GetCachedStatement above for examples and error information.
   scoped_refptr<StatementRef> GetUniqueStatement(const char* sql);
 
+  // Profiling -----------------------------------------------------------------
+
+  // Execution stats for a cached statement, summed over its executions. An
+  // execution runs from the first Step() or Run() until the statement is reset.
+  struct COMPONENT_EXPORT(SQL) StatementStats {
+    StatementStats();
+    StatementStats(const StatementStats&);
+    StatementStats& operator=(const StatementStats&);
+    ~StatementStats();
+
+    // The statement's SQL, as reported by SQLite.
+    std::string sql;
+
+    int64_t executions = 0;
+    // Executions that took at least the slow statement threshold.
+    int64_t slow_executions = 0;
+    // Calls to sqlite3_step(), and how many of them produced a row.
+    int64_t steps = 0;
+    int64_t rows = 0;
+    // Time spent in sqlite3_step(), excluding time spent by the caller between
+    // steps.
+    base::TimeDelta total_time;
+    base::TimeDelta max_time;
+    // Pages that missed the connection's page cache, and had to be read from
+    // the database file or the WAL.
+    int64_t pages_read = 0;
+    // Virtual machine operations, and those spent stepping through a full table
+    // scan. See SQLITE_STMTSTATUS_VM_STEP and SQLITE_STMTSTATUS_FULLSCAN_STEP.
+    int64_t vm_steps = 0;
+    int64_t full_scan_steps = 0;
+  };
+
+  // Starts recording StatementStats for the cached statements run on this
+  // connection. Any statement execution, cached or not, that spends at least
+  // |slow_statement_threshold| in SQLite is reported as a "sql" trace event.
+  //
+  // Profiling adds a clock read and a SQLite status query to every step, so it
+  // is off by default.
+  void EnableStatementProfiling(base::TimeDelta slow_statement_threshold);
+  void DisableStatementProfiling();
+  bool statement_profiling_enabled() const {
+    return statement_profiling_enabled_;
+  }
+
+  // Returns the stats recorded for the cached statement |id|, or nullopt if it
+  // has not finished an execution since profiling was enabled.
+  base::Optional<StatementStats> GetStatementStats(StatementID id) const;
+
+  // Returns the stats recorded for all cached statements.
+  const base::flat_map<StatementID, StatementStats>& statement_stats() const {
+    return statement_stats_;
+  }
+
+  // Discards all recorded stats, without changing whether profiling is enabled.
+  void ResetStatementStats();
+
   // Info querying -------------------------------------------------------------
 
   // Returns true if the given structure exists.  Instead of test-then-create,
@@ -584,6 +684,13 @@ class COMPONENT_EXPORT(SQL) Database {
     // this will return nullptr.
     sqlite3_stmt* stmt() const { return stmt_; }
 
+    // The ID under which the statement is cached, or nullopt for statements
+    // that are not cached.
+    const base::Optional<StatementID>& statement_id() const {
+      return statement_id_;
+    }
+    void set_statement_id(StatementID id) { statement_id_ = id; }
+
     // Destroys the compiled statement and sets it to nullptr. The statement
     // will no longer be active. |forced| is used to indicate if
     // orderly-shutdown checks should apply (see Database::RazeAndClose()).
@@ -607,6 +714,7 @@ class COMPONENT_EXPORT(SQL) Database {
     Database* database_;
     sqlite3_stmt* stmt_;
     bool was_valid_;
+    base::Optional<StatementID> statement_id_;
 
     DISALLOW_COPY_AND_ASSIGN(StatementRef);
   };
@@ -616,6 +724,15 @@ class COMPONENT_EXPORT(SQL) Database {
   // internally in the transaction management code.
   void DoRollback();
 
+  // Returns the number of page cache misses on this connection so far. Used by
+  // Statement to attribute page reads to executions.
+  int GetPageCacheMissCount() const;
+
+  // Called by Statement when |ref| finishes an execution while profiling is
+  // enabled. |execution| holds the stats for that execution alone.
+  void RecordStatementExecution(const StatementRef& ref,
+                                const StatementStats& execution);
+
   // Called by a StatementRef when it's being created or destroyed. See
   // open_statements_ below.
   void StatementRefCreated(StatementRef* ref);
@@ -694,6 +811,9 @@ class COMPONENT_EXPORT(SQL) Database {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
+  bool manual_wal_checkpoints_;
+  bool read_only_;
 
   // Holds references to all cached statements so they remain active.
   //
@@ -747,6 +867,11 @@ class COMPONENT_EXPORT(SQL) Database {
   // Linear histogram for RecordEvent().
   base::HistogramBase* stats_histogram_;
 
+  // See EnableStatementProfiling().
+  bool statement_profiling_enabled_ = false;
+  base::TimeDelta slow_statement_threshold_;
+  base::flat_map<StatementID, StatementStats> statement_stats_;
+
   // Stores the dump provider object when db is open.
   std::unique_ptr<DatabaseMemoryDumpProvider> memory_dump_provider_;
 
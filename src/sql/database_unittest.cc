@@ -823,6 +823,93 @@ TEST_F(SQLDatabaseTest, DeleteNonWal) {
   EXPECT_FALSE(GetPathExists(journal_path));
 }
 
+#if !defined(OS_FUCHSIA)
+TEST_F(SQLDatabaseTest, WalMode) {
+  db().Close();
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  EXPECT_EQ("wal", ExecuteWithResult(&db(), "PRAGMA journal_mode"));
+  // SQLite's automatic checkpoints stay on.
+  EXPECT_EQ("1000", ExecuteWithResult(&db(), "PRAGMA wal_autocheckpoint"));
+
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (1, 2)"));
+  EXPECT_TRUE(GetPathExists(sql::Database::WriteAheadLogPath(db_path())));
+  EXPECT_TRUE(db().CheckpointDatabase());
+}
+
+TEST_F(SQLDatabaseTest, WalModeWithManualCheckpoints) {
+  db().Close();
+  db().set_wal_mode();
+  db().set_manual_wal_checkpoints();
+  ASSERT_TRUE(db().Open(db_path()));
+  EXPECT_EQ("wal", ExecuteWithResult(&db(), "PRAGMA journal_mode"));
+  // Checkpoints only run through CheckpointDatabase().
+  EXPECT_EQ("0", ExecuteWithResult(&db(), "PRAGMA wal_autocheckpoint"));
+
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (1, 2)"));
+  EXPECT_TRUE(db().CheckpointDatabase());
+}
+
+TEST_F(SQLDatabaseTest, ReadOnly) {
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (1, 2)"));
+
+  sql::Database reader;
+  reader.set_read_only();
+  ASSERT_TRUE(reader.Open(db_path()));
+  EXPECT_EQ("1", ExecuteWithResult(&reader, "SELECT a FROM foo"));
+
+  {
+    sql::test::ScopedErrorExpecter expecter;
+    expecter.ExpectError(SQLITE_READONLY);
+    EXPECT_FALSE(reader.Execute("INSERT INTO foo (a, b) VALUES (3, 4)"));
+    ASSERT_TRUE(expecter.SawExpectedErrors());
+  }
+
+  // Read-only connections never create the database.
+  sql::Database missing;
+  missing.set_read_only();
+  {
+    sql::test::ScopedErrorExpecter expecter;
+    expecter.ExpectError(SQLITE_CANTOPEN);
+    EXPECT_FALSE(
+        missing.Open(db_path().DirName().AppendASCII("missing.sqlite")));
+    ASSERT_TRUE(expecter.SawExpectedErrors());
+  }
+}
+
+// A reader on another connection keeps seeing its snapshot while the WAL-mode
+// writer commits, and sees the new data in its next read transaction.
+TEST_F(SQLDatabaseTest, ReadOnlyWithWalWriter) {
+  db().Close();
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a) VALUES (1)"));
+
+  sql::Database reader;
+  reader.set_read_only();
+  ASSERT_TRUE(reader.Open(db_path()));
+  EXPECT_EQ("wal", ExecuteWithResult(&reader, "PRAGMA journal_mode"));
+
+  ASSERT_TRUE(reader.BeginTransaction());
+  EXPECT_EQ("1", ExecuteWithResult(&reader, "SELECT COUNT(*) FROM foo"));
+
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a) VALUES (2)"));
+  EXPECT_EQ("1", ExecuteWithResult(&reader, "SELECT COUNT(*) FROM foo"));
+
+  // The reader still needs the old pages, so the checkpoint is partial, but
+  // does not fail or block.
+  EXPECT_TRUE(db().CheckpointDatabase());
+
+  ASSERT_TRUE(reader.CommitTransaction());
+  EXPECT_EQ("2", ExecuteWithResult(&reader, "SELECT COUNT(*) FROM foo"));
+  EXPECT_TRUE(db().CheckpointDatabase());
+}
+#endif  // !defined(OS_FUCHSIA)
+
 #if defined(OS_POSIX)  // This test operates on POSIX file permissions.
 TEST_F(SQLDatabaseTest, PosixFilePermissions) {
   db().Close();
@@ -0,0 +1,115 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/read_only_database_pool.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/threading/scoped_blocking_call.h"
+#include "base/trace_event/trace_event.h"
+#include "sql/database.h"
+
+namespace sql {
+
+ReadOnlyDatabasePool::ScopedConnection::ScopedConnection(
+    ReadOnlyDatabasePool* pool,
+    std::unique_ptr<Database> db)
+    : pool_(pool), db_(std::move(db)) {}
+
+ReadOnlyDatabasePool::ScopedConnection::ScopedConnection(
+    ScopedConnection&& other)
+    : pool_(other.pool_), db_(std::move(other.db_)) {}
+
+ReadOnlyDatabasePool::ScopedConnection::~ScopedConnection() {
+  if (db_)
+    pool_->Release(std::move(db_));
+}
+
+ReadOnlyDatabasePool::ReadOnlyDatabasePool(const base::FilePath& path,
+                                           size_t max_connections)
+    : path_(path),
+      max_connections_(max_connections),
+      connection_released_(&lock_) {
+  DCHECK_GT(max_connections_, 0u);
+}
+
+ReadOnlyDatabasePool::~ReadOnlyDatabasePool() {
+  base::AutoLock lock(lock_);
+  DCHECK_EQ(idle_connections_.size(), open_connections_)
+      << "All connections must be released before the pool is destroyed";
+}
+
+void ReadOnlyDatabasePool::set_cache_size(int cache_size) {
+  DCHECK_GE(cache_size, 0);
+  cache_size_ = cache_size;
+}
+
+void ReadOnlyDatabasePool::set_histogram_tag(const std::string& tag) {
+  histogram_tag_ = tag;
+}
+
+ReadOnlyDatabasePool::ScopedConnection ReadOnlyDatabasePool::Acquire() {
+  TRACE_EVENT0("sql", "ReadOnlyDatabasePool::Acquire");
+
+  {
+    base::AutoLock lock(lock_);
+    if (idle_connections_.empty() && open_connections_ >= max_connections_) {
+      base::ScopedBlockingCall scoped_blocking_call(
+          FROM_HERE, base::BlockingType::WILL_BLOCK);
+      while (idle_connections_.empty() &&
+             open_connections_ >= max_connections_) {
+        connection_released_.Wait();
+      }
+    }
+
+    if (!idle_connections_.empty()) {
+      std::unique_ptr<Database> db = std::move(idle_connections_.back());
+      idle_connections_.pop_back();
+      return ScopedConnection(this, std::move(db));
+    }
+
+    // Reserve a slot, then open the connection without holding the lock, as
+    // opening does blocking I/O.
+    ++open_connections_;
+  }
+
+  auto db = std::make_unique<Database>();
+  db->set_read_only();
+  if (cache_size_)
+    db->set_cache_size(cache_size_);
+  if (!histogram_tag_.empty())
+    db->set_histogram_tag(histogram_tag_);
+  if (!db->Open(path_)) {
+    base::AutoLock lock(lock_);
+    --open_connections_;
+    connection_released_.Signal();
+    return ScopedConnection(this, nullptr);
+  }
+  return ScopedConnection(this, std::move(db));
+}
+
+size_t ReadOnlyDatabasePool::open_connections_for_testing() const {
+  base::AutoLock lock(lock_);
+  return open_connections_;
+}
+
+void ReadOnlyDatabasePool::Release(std::unique_ptr<Database> db) {
+  // A connection poisoned by its error callback cannot be reused. Drop it, so
+  // that a fresh one is opened in its place.
+  const bool reusable = db->is_open();
+  DCHECK_EQ(db->transaction_nesting(), 0)
+      << "Connections must not be released with an open transaction";
+  if (!reusable)
+    db.reset();
+
+  base::AutoLock lock(lock_);
+  if (reusable)
+    idle_connections_.push_back(std::move(db));
+  else
+    --open_connections_;
+  connection_released_.Signal();
+}
+
+}  // namespace sql
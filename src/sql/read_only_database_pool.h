@@ -0,0 +1,108 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SQL_READ_ONLY_DATABASE_POOL_H_
+#define SQL_READ_ONLY_DATABASE_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/component_export.h"
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+
+namespace sql {
+
+class Database;
+
+// Hands out read-only connections to a database whose writer was opened with
+// Database::set_wal_mode(), so that reads can run on parallel sequences while
+// the writer keeps committing.
+//
+// Connections are opened lazily, up to |max_connections|, and are reused after
+// they are released. Each connection keeps its own statement cache, so
+// statements cached through Database::GetCachedStatement() stay compiled
+// across acquisitions of the same connection.
+//
+// This class is thread-safe. The connections it hands out are not; each one
+// must only be used on the sequence that acquired it, until it is released.
+class COMPONENT_EXPORT(SQL) ReadOnlyDatabasePool {
+ public:
+  // Owns a connection borrowed from the pool, and returns it on destruction.
+  // A null handle is returned if the connection could not be opened.
+  class COMPONENT_EXPORT(SQL) ScopedConnection {
+   public:
+    ScopedConnection(ScopedConnection&& other);
+    ~ScopedConnection();
+
+    explicit operator bool() const { return static_cast<bool>(db_); }
+    Database* get() const { return db_.get(); }
+    Database* operator->() const { return db_.get(); }
+
+   private:
+    friend class ReadOnlyDatabasePool;
+
+    ScopedConnection(ReadOnlyDatabasePool* pool, std::unique_ptr<Database> db);
+
+    ReadOnlyDatabasePool* pool_;
+    std::unique_ptr<Database> db_;
+
+    DISALLOW_COPY_AND_ASSIGN(ScopedConnection);
+  };
+
+  // The database at |path| must outlive the pool, and must already be in WAL
+  // mode when the first connection is acquired.
+  ReadOnlyDatabasePool(const base::FilePath& path, size_t max_connections);
+
+  // All connections must have been released.
+  ~ReadOnlyDatabasePool();
+
+  // Pre-init configuration, applied to every connection the pool opens. These
+  // must be called before the first Acquire(). See the Database setters of the
+  // same name.
+  void set_cache_size(int cache_size);
+  void set_histogram_tag(const std::string& tag);
+
+  // Borrows an idle connection. If all connections are in use, a new one is
+  // opened, unless there are already |max_connections|, in which case this
+  // blocks until another sequence releases one.
+  ScopedConnection Acquire();
+
+  // Returns the number of connections currently open, borrowed or idle.
+  size_t open_connections_for_testing() const;
+
+ private:
+  // Returns |db| to the pool, and wakes up a waiting Acquire().
+  void Release(std::unique_ptr<Database> db);
+
+  const base::FilePath path_;
+  const size_t max_connections_;
+
+  int cache_size_ = 0;
+  std::string histogram_tag_;
+
+  mutable base::Lock lock_;
+
+  // Signaled whenever a connection is released, or a slot for opening one
+  // becomes available.
+  base::ConditionVariable connection_released_;
+
+  // Open connections not currently borrowed.
+  std::vector<std::unique_ptr<Database>> idle_connections_ GUARDED_BY(lock_);
+
+  // Connections that are open or being opened, including borrowed ones.
+  size_t open_connections_ GUARDED_BY(lock_) = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ReadOnlyDatabasePool);
+};
+
+}  // namespace sql
+
+#endif  // SQL_READ_ONLY_DATABASE_POOL_H_
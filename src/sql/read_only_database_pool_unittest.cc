@@ -0,0 +1,166 @@
+// Copyright 2020 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "sql/read_only_database_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/threading/thread.h"
+#include "build/build_config.h"
+#include "sql/database.h"
+#include "sql/statement.h"
+#include "sql/test/scoped_error_expecter.h"
+#include "sql/test/sql_test_base.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/sqlite/sqlite3.h"
+
+namespace sql {
+
+namespace {
+
+#if !defined(OS_FUCHSIA)
+
+class SQLReadOnlyDatabasePoolTest : public SQLTestBase {
+ public:
+  void SetUp() override {
+    SQLTestBase::SetUp();
+
+    db().Close();
+    db().set_wal_mode();
+    ASSERT_TRUE(db().Open(db_path()));
+    ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+    ASSERT_TRUE(db().Execute("INSERT INTO foo (a) VALUES (1)"));
+  }
+
+  static int CountRows(Database* db) {
+    Statement s(db->GetCachedStatement(SQL_FROM_HERE,
+                                       "SELECT COUNT(*) FROM foo"));
+    return s.Step() ? s.ColumnInt(0) : -1;
+  }
+};
+
+TEST_F(SQLReadOnlyDatabasePoolTest, ReusesConnections) {
+  ReadOnlyDatabasePool pool(db_path(), 2);
+
+  Database* first_db = nullptr;
+  {
+    ReadOnlyDatabasePool::ScopedConnection connection = pool.Acquire();
+    ASSERT_TRUE(connection);
+    EXPECT_EQ(1, CountRows(connection.get()));
+    first_db = connection.get();
+  }
+  EXPECT_EQ(1u, pool.open_connections_for_testing());
+
+  // The idle connection is handed out again, with its statement cache intact,
+  // and it sees rows committed since it was last used.
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a) VALUES (2)"));
+  {
+    ReadOnlyDatabasePool::ScopedConnection connection = pool.Acquire();
+    ASSERT_TRUE(connection);
+    EXPECT_EQ(first_db, connection.get());
+    EXPECT_EQ(2, CountRows(connection.get()));
+
+    // A second concurrent borrower gets a new connection.
+    ReadOnlyDatabasePool::ScopedConnection other = pool.Acquire();
+    ASSERT_TRUE(other);
+    EXPECT_NE(first_db, other.get());
+    EXPECT_EQ(2u, pool.open_connections_for_testing());
+  }
+  EXPECT_EQ(2u, pool.open_connections_for_testing());
+}
+
+TEST_F(SQLReadOnlyDatabasePoolTest, ConnectionsAreReadOnly) {
+  ReadOnlyDatabasePool pool(db_path(), 1);
+  ReadOnlyDatabasePool::ScopedConnection connection = pool.Acquire();
+  ASSERT_TRUE(connection);
+
+  sql::test::ScopedErrorExpecter expecter;
+  expecter.ExpectError(SQLITE_READONLY);
+  EXPECT_FALSE(connection->Execute("INSERT INTO foo (a) VALUES (2)"));
+  ASSERT_TRUE(expecter.SawExpectedErrors());
+}
+
+TEST_F(SQLReadOnlyDatabasePoolTest, AcquireWaitsForRelease) {
+  ReadOnlyDatabasePool pool(db_path(), 1);
+  base::Thread thread("ReadOnlyDatabasePoolTest");
+  ASSERT_TRUE(thread.Start());
+
+  auto connection = std::make_unique<ReadOnlyDatabasePool::ScopedConnection>(
+      pool.Acquire());
+  ASSERT_TRUE(*connection);
+  Database* held_db = connection->get();
+
+  // The pool is exhausted, so the other thread blocks in Acquire() until the
+  // connection above is released.
+  base::WaitableEvent acquired;
+  Database* acquired_db = nullptr;
+  thread.task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(
+                     [](ReadOnlyDatabasePool* pool, Database** acquired_db,
+                        base::WaitableEvent* acquired) {
+                       ReadOnlyDatabasePool::ScopedConnection connection =
+                           pool->Acquire();
+                       *acquired_db = connection.get();
+                       EXPECT_EQ(1, CountRows(connection.get()));
+                       acquired->Signal();
+                     },
+                     &pool, &acquired_db, &acquired));
+  EXPECT_FALSE(acquired.TimedWait(base::TimeDelta::FromMilliseconds(50)));
+
+  connection.reset();
+  acquired.Wait();
+  EXPECT_EQ(held_db, acquired_db);
+  thread.Stop();
+  EXPECT_EQ(1u, pool.open_connections_for_testing());
+}
+
+// Readers on other threads keep making progress while the writer commits and
+// checkpoints.
+TEST_F(SQLReadOnlyDatabasePoolTest, ReadsDuringWrites) {
+  constexpr int kReaders = 3;
+  constexpr int kReadsPerReader = 50;
+  constexpr int kWrites = 50;
+
+  ReadOnlyDatabasePool pool(db_path(), kReaders);
+  std::vector<std::unique_ptr<base::Thread>> threads;
+  for (int i = 0; i < kReaders; ++i) {
+    threads.push_back(
+        std::make_unique<base::Thread>("ReadOnlyDatabasePoolTest"));
+    ASSERT_TRUE(threads.back()->Start());
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(
+                       [](ReadOnlyDatabasePool* pool, int reads) {
+                         int last_count = 0;
+                         for (int j = 0; j < reads; ++j) {
+                           ReadOnlyDatabasePool::ScopedConnection connection =
+                               pool->Acquire();
+                           ASSERT_TRUE(connection);
+                           int count = CountRows(connection.get());
+                           EXPECT_GE(count, last_count);
+                           last_count = count;
+                         }
+                       },
+                       &pool, kReadsPerReader));
+  }
+
+  for (int i = 0; i < kWrites; ++i) {
+    ASSERT_TRUE(db().Execute("INSERT INTO foo (a) VALUES (2)"));
+    if (i % 10 == 0)
+      EXPECT_TRUE(db().CheckpointDatabase());
+  }
+
+  for (auto& thread : threads)
+    thread->Stop();
+  EXPECT_EQ(kWrites + 1, CountRows(&db()));
+}
+
+#endif  // !defined(OS_FUCHSIA)
+
+}  // namespace
+
+}  // namespace sql
@@ -11,6 +11,7 @@
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "third_party/sqlite/sqlite3.h"
 
 namespace sql {
@@ -61,7 +62,30 @@ int Statement::StepInternal() {
   ref_->InitScopedBlockingCall(FROM_HERE, &scoped_blocking_call);
 
   stepped_ = true;
+  Database* database = ref_->database();
+  if (!database || !database->statement_profiling_enabled())
+    return CheckError(sqlite3_step(ref_->stmt()));
+
+  // SQLite's VM counters accumulate across executions, including unprofiled
+  // ones, so start them afresh at the first profiled step of this execution.
+  if (!execution_stats_.steps) {
+    sqlite3_stmt_status(ref_->stmt(), SQLITE_STMTSTATUS_VM_STEP,
+                        /*resetFlg=*/1);
+    sqlite3_stmt_status(ref_->stmt(), SQLITE_STMTSTATUS_FULLSCAN_STEP,
+                        /*resetFlg=*/1);
+  }
+
+  const int cache_misses = database->GetPageCacheMissCount();
+  const base::TimeTicks start = base::TimeTicks::Now();
   int ret = sqlite3_step(ref_->stmt());
+
+  // Recorded before CheckError(), as the error callback may close the database.
+  execution_stats_.total_time += base::TimeTicks::Now() - start;
+  execution_stats_.pages_read +=
+      database->GetPageCacheMissCount() - cache_misses;
+  ++execution_stats_.steps;
+  if (ret == SQLITE_ROW)
+    ++execution_stats_.rows;
   return CheckError(ret);
 }
 
@@ -77,6 +101,7 @@ bool Statement::Step() {
 void Statement::Reset(bool clear_bound_vars) {
   base::Optional<base::ScopedBlockingCall> scoped_blocking_call;
   ref_->InitScopedBlockingCall(FROM_HERE, &scoped_blocking_call);
+  RecordExecutionStats();
   if (is_valid()) {
     if (clear_bound_vars)
       sqlite3_clear_bindings(ref_->stmt());
@@ -97,6 +122,22 @@ void Statement::Reset(bool clear_bound_vars) {
   stepped_ = false;
 }
 
+void Statement::RecordExecutionStats() {
+  if (!execution_stats_.steps)
+    return;
+
+  Database* database = ref_->database();
+  if (is_valid() && database && database->statement_profiling_enabled()) {
+    // The counters were reset by the first step of this execution.
+    execution_stats_.vm_steps = sqlite3_stmt_status(
+        ref_->stmt(), SQLITE_STMTSTATUS_VM_STEP, /*resetFlg=*/0);
+    execution_stats_.full_scan_steps = sqlite3_stmt_status(
+        ref_->stmt(), SQLITE_STMTSTATUS_FULLSCAN_STEP, /*resetFlg=*/0);
+    database->RecordStatementExecution(*ref_, execution_stats_);
+  }
+  execution_stats_ = Database::StatementStats();
+}
+
 bool Statement::Succeeded() const {
   return is_valid() && succeeded_;
 }
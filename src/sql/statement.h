@@ -186,11 +186,19 @@ class COMPONENT_EXPORT(SQL) Statement {
   // guaranteed non-null.
   scoped_refptr<Database::StatementRef> ref_;
 
+  // Reports the execution that just ended to the Database, if it was profiled,
+  // and clears |execution_stats_|. Called by Reset().
+  void RecordExecutionStats();
+
   // Set after Step() or Run() are called, reset by Reset().  Used to
   // prevent accidental calls to API functions which would not work
   // correctly after stepping has started.
   bool stepped_;
 
+  // Stats for the current execution, gathered while the Database has statement
+  // profiling enabled. See Database::EnableStatementProfiling().
+  Database::StatementStats execution_stats_;
+
   // See Succeeded() for what this holds.
   bool succeeded_;
 
@@ -115,3 +115,67 @@ TEST_F(SQLStatementTest, Reset) {
   s.Reset(true);
   ASSERT_FALSE(s.Step());
 }
+
+TEST_F(SQLStatementTest, Profiling) {
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a, b)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (3, 12)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (4, 13)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo (a, b) VALUES (5, 14)"));
+
+  const sql::StatementID kSelectId = SQL_FROM_HERE;
+  auto select_all = [this, kSelectId]() {
+    sql::Statement s(db().GetCachedStatement(kSelectId, "SELECT b FROM foo"));
+    int rows = 0;
+    while (s.Step())
+      ++rows;
+    return rows;
+  };
+
+  // Nothing is recorded until profiling is enabled.
+  EXPECT_EQ(3, select_all());
+  EXPECT_FALSE(db().GetStatementStats(kSelectId));
+
+  db().EnableStatementProfiling(base::TimeDelta::Max());
+  EXPECT_EQ(3, select_all());
+  base::Optional<sql::Database::StatementStats> first_stats =
+      db().GetStatementStats(kSelectId);
+  ASSERT_TRUE(first_stats);
+  EXPECT_EQ(3, select_all());
+
+  base::Optional<sql::Database::StatementStats> stats =
+      db().GetStatementStats(kSelectId);
+  ASSERT_TRUE(stats);
+  EXPECT_EQ("SELECT b FROM foo", stats->sql);
+  EXPECT_EQ(2, stats->executions);
+  EXPECT_EQ(0, stats->slow_executions);
+  EXPECT_EQ(8, stats->steps);
+  EXPECT_EQ(6, stats->rows);
+  EXPECT_GE(stats->total_time, stats->max_time);
+  EXPECT_GT(stats->vm_steps, 0);
+  EXPECT_GT(stats->full_scan_steps, 0);
+
+  // Both executions did the same work. The VM counters of the unprofiled
+  // execution above are not folded into the first profiled one.
+  EXPECT_EQ(2 * first_stats->vm_steps, stats->vm_steps);
+  EXPECT_EQ(2 * first_stats->full_scan_steps, stats->full_scan_steps);
+
+  // Statements that are not cached are not aggregated.
+  {
+    sql::Statement s(db().GetUniqueStatement("SELECT a FROM foo"));
+    ASSERT_TRUE(s.Step());
+  }
+  EXPECT_EQ(1u, db().statement_stats().size());
+
+  // With a zero threshold, every execution counts as slow.
+  db().ResetStatementStats();
+  db().EnableStatementProfiling(base::TimeDelta());
+  EXPECT_EQ(3, select_all());
+  stats = db().GetStatementStats(kSelectId);
+  ASSERT_TRUE(stats);
+  EXPECT_EQ(1, stats->executions);
+  EXPECT_EQ(1, stats->slow_executions);
+
+  db().DisableStatementProfiling();
+  EXPECT_EQ(3, select_all());
+  EXPECT_EQ(1, db().GetStatementStats(kSelectId)->executions);
+}